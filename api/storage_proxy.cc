@@ -14,7 +14,10 @@
 #include "db/config.hh"
 #include "utils/histogram.hh"
 #include "replica/database.hh"
+#include "tracing/stage_latencies.hh"
 #include <seastar/core/scheduling_specific.hh>
+#include <seastar/core/map_reduce.hh>
+#include <boost/range/irange.hpp>
 
 namespace api {
 
@@ -512,6 +515,46 @@ void set_storage_proxy(http_context& ctx, routes& r, sharded<service::storage_se
     sp::get_range_latency.set(r, [&ctx](std::unique_ptr<request> req) {
         return total_latency(ctx, &service::storage_proxy_stats::stats::range);
     });
+
+    sp::set_stage_latency_sampling_period.set(r, [](std::unique_ptr<request> req) {
+        auto period_param = req->get_query_param("period");
+        uint32_t period;
+        try {
+            period = boost::lexical_cast<uint32_t>(period_param);
+        } catch (boost::bad_lexical_cast&) {
+            throw httpd::bad_param_exception(format("Bad format in a sampling period value: \"{}\"", period_param));
+        }
+        return smp::invoke_on_all([period] {
+            tracing::local_stage_latencies().set_sampling_period(period);
+        }).then([] {
+            return make_ready_future<json::json_return_type>(json_void());
+        });
+    });
+
+    sp::get_stage_latency_sampling_period.set(r, [](std::unique_ptr<request> req) {
+        return make_ready_future<json::json_return_type>(tracing::local_stage_latencies().sampling_period());
+    });
+
+    sp::get_stage_estimated_histogram.set(r, [](std::unique_ptr<request> req) {
+        auto stage = tracing::stage_from_name(req->param["stage"]);
+        if (!stage) {
+            throw httpd::bad_param_exception(format("Unknown stage: \"{}\"", req->param["stage"]));
+        }
+        return map_reduce(boost::irange(0u, smp::count), [stage = *stage] (unsigned shard) {
+            return smp::submit_to(shard, [stage] {
+                return tracing::local_stage_latencies().histogram(stage);
+            });
+        }, tracing::stage_latency_histogram(), [] (tracing::stage_latency_histogram a, const tracing::stage_latency_histogram& b) {
+            return std::move(a.merge(b));
+        }).then([] (const tracing::stage_latency_histogram& val) {
+            utils_json::estimated_histogram res;
+            for (size_t i = 0; i < val.size(); i++) {
+                res.buckets.push(val.get(i));
+                res.bucket_offsets.push(val.get_bucket_lower_limit(i));
+            }
+            return make_ready_future<json::json_return_type>(res);
+        });
+    });
 }
 
 }
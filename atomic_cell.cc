@@ -11,6 +11,9 @@
 #include "counters.hh"
 #include "types.hh"
 
+#include <lz4.h>
+#include <seastar/core/byteorder.hh>
+
 atomic_cell atomic_cell::make_dead(api::timestamp_type timestamp, gc_clock::time_point deletion_time) {
     return atomic_cell_type::make_dead(timestamp, deletion_time);
 }
@@ -66,6 +69,52 @@ atomic_cell::atomic_cell(const abstract_type& type, atomic_cell_view other)
     set_view(_data);
 }
 
+// Values shorter than that rarely compress well enough to pay for the size
+// prefix and for decompressing them on every read.
+static constexpr size_t min_compressed_value_size = 64;
+// Values are linearized for compression, bound the size of the temporary buffers.
+static constexpr size_t max_compressed_value_size = 128 * 1024;
+
+std::optional<atomic_cell> atomic_cell::make_compressed(atomic_cell_view cell) {
+    if (!cell.is_live() || cell.is_counter_update() || cell.is_compressed()) {
+        return std::nullopt;
+    }
+    auto value = cell.value();
+    if (value.size() < min_compressed_value_size || value.size() > max_compressed_value_size) {
+        return std::nullopt;
+    }
+    return with_linearized(value, [&] (bytes_view in) -> std::optional<atomic_cell> {
+        bytes out(bytes::initialized_later(), sizeof(uint32_t) + LZ4_COMPRESSBOUND(in.size()));
+        write_be<uint32_t>(reinterpret_cast<char*>(out.data()), in.size());
+        auto dst = reinterpret_cast<char*>(out.data()) + sizeof(uint32_t);
+#ifdef HAVE_LZ4_COMPRESS_DEFAULT
+        auto len = LZ4_compress_default(reinterpret_cast<const char*>(in.data()), dst, in.size(), out.size() - sizeof(uint32_t));
+#else
+        auto len = LZ4_compress(reinterpret_cast<const char*>(in.data()), dst, in.size());
+#endif
+        // Require saving at least 1/8th of the value, otherwise the CPU
+        // spent on decompressing isn't worth the memory.
+        if (len <= 0 || sizeof(uint32_t) + size_t(len) > in.size() - in.size() / 8) {
+            return std::nullopt;
+        }
+        return atomic_cell(atomic_cell_type::make_with_value(cell._view, bytes_view(out.data(), sizeof(uint32_t) + len), true));
+    });
+}
+
+atomic_cell atomic_cell::make_decompressed(atomic_cell_view cell) {
+    assert(cell.is_compressed());
+    auto value = cell.value();
+    auto size = read_simple<uint32_t>(value);
+    return with_linearized(value, [&] (bytes_view in) {
+        bytes out(bytes::initialized_later(), size);
+        auto ret = LZ4_decompress_safe(reinterpret_cast<const char*>(in.data()), reinterpret_cast<char*>(out.data()), in.size(), size);
+        if (ret < 0 || size_t(ret) != size) {
+            throw std::runtime_error(format("Failed to decompress cell value: expected {:d} bytes, got {:d}", size, ret));
+        }
+        return atomic_cell(atomic_cell_type::make_with_value(cell._view, out, false));
+    });
+}
+
 // Based on:
 //  - org.apache.cassandra.db.AbstractCell#reconcile()
 //  - org.apache.cassandra.db.BufferExpiringCell#reconcile()
@@ -79,6 +128,13 @@ compare_atomic_cell_for_merge(atomic_cell_view left, atomic_cell_view right) {
         return left.is_live() ? std::strong_ordering::less : std::strong_ordering::greater;
     }
     if (left.is_live()) {
+        if (left.is_compressed() || right.is_compressed()) [[unlikely]] {
+            // Compressed cells reconcile like their decompressed form, so that
+            // the row cache picks the same cell as everything else does.
+            auto l = left.is_compressed() ? std::optional(atomic_cell::make_decompressed(left)) : std::nullopt;
+            auto r = right.is_compressed() ? std::optional(atomic_cell::make_decompressed(right)) : std::nullopt;
+            return compare_atomic_cell_for_merge(l ? atomic_cell_view(*l) : left, r ? atomic_cell_view(*r) : right);
+        }
         auto c = compare_unsigned(left.value(), right.value()) <=> 0;
         if (c != 0) {
             return c;
@@ -151,6 +207,11 @@ bool atomic_cell_or_collection::equals(const abstract_type& type, const atomic_c
                     return false;
                 }
             }
+            if (a.is_compressed() != b.is_compressed()) {
+                auto ad = a.is_compressed() ? atomic_cell::make_decompressed(a) : atomic_cell(type, a);
+                auto bd = b.is_compressed() ? atomic_cell::make_decompressed(b) : atomic_cell(type, b);
+                return atomic_cell_view(ad).value() == atomic_cell_view(bd).value();
+            }
             return a.value() == b.value();
         }
         return a.deletion_time() == b.deletion_time();
@@ -167,7 +228,8 @@ size_t atomic_cell_or_collection::external_memory_usage(const abstract_type& t)
 std::ostream&
 operator<<(std::ostream& os, const atomic_cell_view& acv) {
     if (acv.is_live()) {
-        fmt::print(os, "atomic_cell{{{},ts={:d},expiry={:d},ttl={:d}}}",
+        fmt::print(os, "atomic_cell{{{}{},ts={:d},expiry={:d},ttl={:d}}}",
+            acv.is_compressed() ? "compressed=" : "",
             acv.is_counter_update()
                     ? "counter_update_value=" + to_sstring(acv.counter_update_value())
                     : to_hex(to_bytes(acv.value())),
@@ -200,6 +262,8 @@ operator<<(std::ostream& os, const atomic_cell_view::printer& acvp) {
                 auto ccv = counter_cell_view(acv);
                 cell_value_string_builder << ::join(", ", ccv.shards());
             }
+        } else if (acv.is_compressed()) {
+            cell_value_string_builder << type.to_string(to_bytes(atomic_cell::make_decompressed(acv).value()));
         } else {
             cell_value_string_builder << type.to_string(to_bytes(acv.value()));
         }
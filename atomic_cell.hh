@@ -18,6 +18,7 @@
 #include <cstdint>
 #include <iosfwd>
 #include <concepts>
+#include <optional>
 #include "utils/fragmented_temporary_buffer.hh"
 
 #include "serializer.hh"
@@ -69,12 +70,16 @@ static T get_field(Input in, unsigned offset = 0) {
  *
  *  <live>  := <int8_t:flags><int64_t:timestamp>(<int64_t:expiry><int32_t:ttl>)?<value>
  *  <dead>  := <int8_t:    0><int64_t:timestamp><int64_t:deletion_time>
+ *
+ * When COMPRESSED_FLAG is set, <value> is <uint32_t:uncompressed_size><LZ4 block>.
+ * Compressed cells are only kept in the row cache, see atomic_cell::make_compressed().
  */
 class atomic_cell_type final {
 private:
     static constexpr int8_t LIVE_FLAG = 0x01;
     static constexpr int8_t EXPIRY_FLAG = 0x02; // When present, expiry field is present. Set only for live cells
     static constexpr int8_t COUNTER_UPDATE_FLAG = 0x08; // Cell is a counter update.
+    static constexpr int8_t COMPRESSED_FLAG = 0x10; // The value is compressed. Set only for live cells
     static constexpr unsigned flags_size = 1;
     static constexpr unsigned timestamp_offset = flags_size;
     static constexpr unsigned timestamp_size = 8;
@@ -95,6 +100,9 @@ class atomic_cell_type final {
     static bool is_live_and_has_ttl(atomic_cell_value_view cell) {
         return cell.front() & EXPIRY_FLAG;
     }
+    static bool is_compressed(atomic_cell_value_view cell) {
+        return cell.front() & COMPRESSED_FLAG;
+    }
     static bool is_dead(atomic_cell_value_view cell) {
         return !is_live(cell);
     }
@@ -176,6 +184,17 @@ class atomic_cell_type final {
         set_value(b, value_offset, value);
         return b;
     }
+    // Returns a copy of a live cell, with `value` as its value, and with
+    // COMPRESSED_FLAG set if `compressed`.
+    static managed_bytes make_with_value(atomic_cell_value_view cell, bytes_view value, bool compressed) {
+        auto value_offset = flags_size + timestamp_size + bool(cell.front() & EXPIRY_FLAG) * (expiry_size + ttl_size);
+        managed_bytes b(managed_bytes::initialized_later(), value_offset + value.size());
+        auto out = managed_bytes_mutable_view(b);
+        write_fragmented(out, cell.prefix(value_offset));
+        write_fragmented(out, single_fragmented_view(value));
+        b[0] = compressed ? (b[0] | COMPRESSED_FLAG) : (b[0] & ~COMPRESSED_FLAG);
+        return b;
+    }
     static managed_bytes make_live_uninitialized(api::timestamp_type timestamp, size_t size) {
         auto value_offset = flags_size + timestamp_size;
         managed_bytes b(managed_bytes::initialized_later(), value_offset + size);
@@ -221,6 +240,10 @@ class basic_atomic_cell_view {
     bool is_live_and_has_ttl() const {
         return atomic_cell_type::is_live_and_has_ttl(_view);
     }
+    // If true, value() is compressed and has to be read through atomic_cell::make_decompressed().
+    bool is_compressed() const {
+        return atomic_cell_type::is_compressed(_view);
+    }
     bool is_dead(gc_clock::time_point now) const {
         return atomic_cell_type::is_dead(_view) || has_expired(now);
     }
@@ -371,6 +394,14 @@ class atomic_cell final : public basic_atomic_cell_view<mutable_view::yes> {
         }
     }
     static atomic_cell make_live_uninitialized(const abstract_type& type, api::timestamp_type timestamp, size_t size);
+    // Returns a copy of the cell with its value compressed, or std::nullopt if
+    // the cell is not worth compressing. Must not be called on counter cells.
+    //
+    // Compressed cells are meant to be kept in the row cache only, everything
+    // which reads cells from the cache and passes them on decompresses them.
+    static std::optional<atomic_cell> make_compressed(atomic_cell_view cell);
+    // Returns a copy of a compressed cell with its value decompressed.
+    static atomic_cell make_decompressed(atomic_cell_view cell);
     friend class atomic_cell_or_collection;
     friend std::ostream& operator<<(std::ostream& os, const atomic_cell& ac);
 
@@ -46,6 +46,11 @@ struct appending_hash<atomic_cell_view> {
                 feed_hash(h, cell.expiry());
                 feed_hash(h, cell.ttl());
             }
+            if (cell.is_compressed()) [[unlikely]] {
+                auto decompressed = atomic_cell::make_decompressed(cell);
+                feed_hash(h, atomic_cell_view(decompressed).value());
+                return;
+            }
             feed_hash(h, cell.value());
         } else {
             feed_hash(h, cell.deletion_time());
@@ -574,7 +574,17 @@ void cache_flat_mutation_reader::maybe_add_to_cache(const clustering_row& cr) {
     }
     auto rt_opt = _rt_assembler.flush(*_schema, position_in_partition::after_key(cr.key()));
     clogger.trace("csm {}: populate({})", fmt::ptr(this), clustering_row::printer(*_schema, cr));
-    _lsa_manager.run_in_update_section_with_allocator([this, &cr, &rt_opt] {
+    if (_read_context.digest_requested()) {
+        cr.cells().prepare_hash(*_schema, column_kind::regular_column);
+    }
+    // Compressed outside of the update section, so that the temporary copy
+    // is not allocated in LSA memory.
+    std::optional<deletable_row> compressed_row;
+    if (table_schema().caching_options().compressed()) {
+        compressed_row.emplace(table_schema(), cr.as_deletable_row());
+        compressed_row->cells().compress_cells(table_schema(), column_kind::regular_column);
+    }
+    _lsa_manager.run_in_update_section_with_allocator([this, &cr, &rt_opt, &compressed_row] {
         mutation_partition& mp = _snp->version()->partition();
 
         if (rt_opt) {
@@ -584,11 +594,9 @@ void cache_flat_mutation_reader::maybe_add_to_cache(const clustering_row& cr) {
 
         rows_entry::tri_compare cmp(table_schema());
 
-        if (_read_context.digest_requested()) {
-            cr.cells().prepare_hash(*_schema, column_kind::regular_column);
-        }
         auto new_entry = alloc_strategy_unique_ptr<rows_entry>(
-            current_allocator().construct<rows_entry>(table_schema(), cr.key(), cr.as_deletable_row()));
+            current_allocator().construct<rows_entry>(table_schema(), cr.key(),
+                                                      compressed_row ? *compressed_row : cr.as_deletable_row()));
         new_entry->set_continuous(false);
         auto it = _next_row.iterators_valid() ? _next_row.get_iterator_in_latest_version()
                                               : mp.clustered_rows().lower_bound(cr.key(), cmp);
@@ -896,12 +904,18 @@ void cache_flat_mutation_reader::maybe_add_to_cache(const static_row& sr) {
     if (can_populate()) {
         clogger.trace("csm {}: populate({})", fmt::ptr(this), static_row::printer(*_schema, sr));
         _read_context.cache().on_static_row_insert();
+        if (_read_context.digest_requested()) {
+            sr.cells().prepare_hash(*_schema, column_kind::static_column);
+        }
+        std::optional<row> compressed_cells;
+        if (table_schema().caching_options().compressed()) {
+            compressed_cells.emplace(table_schema(), column_kind::static_column, sr.cells());
+            compressed_cells->compress_cells(table_schema(), column_kind::static_column);
+        }
         _lsa_manager.run_in_update_section_with_allocator([&] {
-            if (_read_context.digest_requested()) {
-                sr.cells().prepare_hash(*_schema, column_kind::static_column);
-            }
             // Static row is the same under table and query schema
-            _snp->version()->partition().static_row().apply(table_schema(), column_kind::static_column, sr.cells());
+            _snp->version()->partition().static_row().apply(table_schema(), column_kind::static_column,
+                                                            compressed_cells ? *compressed_cells : sr.cells());
         });
     } else {
         _read_context.cache().on_mispopulate();
@@ -12,8 +12,8 @@
 #include "exceptions/exceptions.hh"
 #include "utils/rjson.hh"
 
-caching_options::caching_options(sstring k, sstring r, bool enabled)
-        : _key_cache(k), _row_cache(r), _enabled(enabled) {
+caching_options::caching_options(sstring k, sstring r, bool enabled, bool compressed)
+        : _key_cache(k), _row_cache(r), _enabled(enabled), _compressed(compressed) {
     if ((k != "ALL") && (k != "NONE")) {
         throw exceptions::configuration_exception("Invalid key value: " + k); 
     }
@@ -40,6 +40,9 @@ caching_options::to_map() const {
     if (!_enabled) {
         res.insert({"enabled", "false"});
     }
+    if (_compressed) {
+        res.insert({"compression", "LZ4"});
+    }
     return res;
 }
 
@@ -58,6 +61,7 @@ caching_options::from_map(const std::map<sstring, sstring>& map) {
     sstring k = default_key;
     sstring r = default_row;
     bool e = true;
+    bool c = false;
 
     for (auto& p : map) {
         if (p.first == "keys") {
@@ -66,11 +70,17 @@ caching_options::from_map(const std::map<sstring, sstring>& map) {
             r = p.second;
         } else if (p.first == "enabled") {
             e = p.second == "true";
+        } else if (p.first == "compression") {
+            if (p.second == "LZ4") {
+                c = true;
+            } else if (p.second != "NONE") {
+                throw exceptions::configuration_exception(format("Invalid caching compression: {}, must be LZ4 or NONE", p.second));
+            }
         } else {
             throw exceptions::configuration_exception(format("Invalid caching option: {}", p.first));
         }
     }
-    return caching_options(k, r, e);
+    return caching_options(k, r, e, c);
 }
 
 caching_options
@@ -81,7 +91,7 @@ caching_options::from_sstring(const sstring& str) {
 bool
 caching_options::operator==(const caching_options& other) const {
     return _key_cache == other._key_cache && _row_cache == other._row_cache
-        && _enabled == other._enabled;
+        && _enabled == other._enabled && _compressed == other._compressed;
 }
 
 bool
@@ -25,7 +25,9 @@ class caching_options {
     sstring _key_cache;
     sstring _row_cache;
     bool _enabled = true;
-    caching_options(sstring k, sstring r, bool enabled);
+    // Cells are kept compressed in the row cache, see atomic_cell::make_compressed().
+    bool _compressed = false;
+    caching_options(sstring k, sstring r, bool enabled, bool compressed = false);
 
     friend class schema;
     caching_options();
@@ -34,6 +36,10 @@ class caching_options {
         return _enabled;
     }
 
+    bool compressed() const {
+        return _compressed;
+    }
+
     std::map<sstring, sstring> to_map() const;
 
     sstring to_sstring() const;
@@ -891,9 +891,11 @@ void compacted_fragments_writer::consume_end_of_stream() {
 }
 
 class reshape_compaction : public compaction {
+    compaction_type_options::reshape _options;
 public:
-    reshape_compaction(table_state& table_s, compaction_descriptor descriptor, compaction_data& cdata)
-        : compaction(table_s, std::move(descriptor), cdata) {
+    reshape_compaction(table_state& table_s, compaction_descriptor descriptor, compaction_data& cdata, compaction_type_options::reshape options)
+        : compaction(table_s, std::move(descriptor), cdata)
+        , _options(options) {
     }
 
     virtual sstables::sstable_set make_sstable_set_for_input() const override {
@@ -901,6 +903,18 @@ class reshape_compaction : public compaction {
     }
 
     flat_mutation_reader_v2 make_sstable_reader() const override {
+        if (_options.for_other_shard) {
+            // Reshape input is never shared, all of it belongs to the shard which lent the job.
+            return _compacting->make_range_sstable_reader(_schema,
+                    _permit,
+                    query::full_partition_range,
+                    _schema->full_slice(),
+                    _io_priority,
+                    tracing::trace_state_ptr(),
+                    ::streamed_mutation::forwarding::no,
+                    ::mutation_reader::forwarding::no,
+                    default_read_monitor_generator());
+        }
         return _compacting->make_local_shard_sstable_reader(_schema,
                 _permit,
                 query::full_partition_range,
@@ -1611,8 +1625,8 @@ static std::unique_ptr<compaction> make_compaction(table_state& table_s, sstable
         sstables::compaction_descriptor&& descriptor;
         compaction_data& cdata;
 
-        std::unique_ptr<compaction> operator()(compaction_type_options::reshape) {
-            return std::make_unique<reshape_compaction>(table_s, std::move(descriptor), cdata);
+        std::unique_ptr<compaction> operator()(compaction_type_options::reshape options) {
+            return std::make_unique<reshape_compaction>(table_s, std::move(descriptor), cdata, options);
         }
         std::unique_ptr<compaction> operator()(compaction_type_options::reshard) {
             return std::make_unique<resharding_compaction>(table_s, std::move(descriptor), cdata);
@@ -78,6 +78,9 @@ class compaction_type_options {
     struct reshard {
     };
     struct reshape {
+        // The input sstables belong to another shard, which lent the job to
+        // this one, see sstables::sstable_directory::lend_reshape_job().
+        bool for_other_shard = false;
     };
 private:
     using options_variant = std::variant<regular, cleanup, upgrade, scrub, reshard, reshape>;
@@ -90,8 +93,8 @@ class compaction_type_options {
     }
 
 public:
-    static compaction_type_options make_reshape() {
-        return compaction_type_options(reshape{});
+    static compaction_type_options make_reshape(bool for_other_shard = false) {
+        return compaction_type_options(reshape{for_other_shard});
     }
 
     static compaction_type_options make_reshard() {
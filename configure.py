@@ -411,6 +411,7 @@ scylla_tests = set([
     'test/boost/flush_queue_test',
     'test/boost/fragmented_temporary_buffer_test',
     'test/boost/frozen_mutation_test',
+    'test/boost/gossiper_test',
     'test/boost/gossiping_property_file_snitch_test',
     'test/boost/hash_test',
     'test/boost/hashers_test',
@@ -992,6 +993,7 @@ scylla_core = (['replica/database.cc',
                 'auth/role_or_anonymous.cc',
                 'auth/sasl_challenge.cc',
                 'tracing/tracing.cc',
+                'tracing/stage_latencies.cc',
                 'tracing/trace_keyspace_helper.cc',
                 'tracing/trace_state.cc',
                 'tracing/tracing_backend_registry.cc',
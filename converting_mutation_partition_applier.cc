@@ -21,7 +21,9 @@ converting_mutation_partition_applier::is_compatible(const column_definition& ne
 atomic_cell
 converting_mutation_partition_applier::upgrade_cell(const abstract_type& new_type, const abstract_type& old_type, atomic_cell_view cell,
                                 atomic_cell::collection_member cm) {
-    if (cell.is_live() && !old_type.is_counter()) {
+    // Compressed cells are upgraded in row cache entries. Compatible types
+    // have compatible values, so they can stay compressed.
+    if (cell.is_live() && !old_type.is_counter() && !cell.is_compressed()) {
         if (cell.is_live_and_has_ttl()) {
             return atomic_cell::make_live(new_type, cell.timestamp(), cell.value(), cell.expiry(), cell.ttl(), cm);
         }
@@ -126,14 +126,14 @@ struct row_data_from_partition_slice {
     const selection& sel;
 };
 
-/// Returns col's value from queried data.
-managed_bytes_opt get_value(const column_value& col, const evaluation_inputs& inputs) {
+/// Returns a view of col's value in the queried data.
+std::optional<managed_bytes_view> get_value_view(const column_value& col, const evaluation_inputs& inputs) {
     auto cdef = col.col;
     switch (cdef->kind) {
         case column_kind::partition_key:
-            return managed_bytes((*inputs.partition_key)[cdef->id]);
+            return managed_bytes_view(bytes_view((*inputs.partition_key)[cdef->id]));
         case column_kind::clustering_key:
-            return managed_bytes((*inputs.clustering_key)[cdef->id]);
+            return managed_bytes_view(bytes_view((*inputs.clustering_key)[cdef->id]));
         case column_kind::static_column:
             [[fallthrough]];
         case column_kind::regular_column: {
@@ -143,13 +143,39 @@ managed_bytes_opt get_value(const column_value& col, const evaluation_inputs& in
                         format("Column definition {} does not match any column in the query selection",
                         cdef->name_as_text()));
             }
-            return managed_bytes_opt((*inputs.static_and_regular_columns)[index]);
+            const managed_bytes_opt& value = (*inputs.static_and_regular_columns)[index];
+            if (!value) {
+                return std::nullopt;
+            }
+            return managed_bytes_view(*value);
         }
         default:
             throw exceptions::unsupported_operation_exception("Unknown column kind");
     }
 }
 
+/// Returns col's value from queried data.
+managed_bytes_opt get_value(const column_value& col, const evaluation_inputs& inputs) {
+    auto value = get_value_view(col, inputs);
+    if (!value) {
+        return std::nullopt;
+    }
+    return managed_bytes(*value);
+}
+
+/// Returns a view of the constant's value, or nullopt if it is null or unset.
+std::optional<managed_bytes_view> get_value_view(const constant& c) {
+    if (c.value.is_null_or_unset()) {
+        return std::nullopt;
+    }
+    return c.value.view().with_value(overloaded_functor{
+        [] (const managed_bytes_view& v) { return v; },
+        [] (const fragmented_temporary_buffer::view&) -> managed_bytes_view {
+            on_internal_error(expr_logger, "get_value_view: constant does not hold a managed_bytes value");
+        },
+    });
+}
+
 managed_bytes_opt
 get_value(const subscript& s, const evaluation_inputs& inputs) {
     const column_definition* cdef = get_subscripted_column(s).col;
@@ -282,6 +308,26 @@ bool limits(const expression& col, oper_t op, const expression& rhs, const evalu
     return b ? limits(*lhs, op, *b, type_of(col)->without_reversed()) : false;
 }
 
+/// Evaluates `col op rhs` without copying either side, when rhs is a constant.
+///
+/// This is the common case once bind markers and pure functions were folded by
+/// fold_constants(). Returns nullopt if rhs isn't a constant and the caller
+/// has to fall back to evaluate(). The results match equal() and limits().
+std::optional<bool> compare_with_constant(const column_value& col, oper_t op, const expression& rhs,
+        const evaluation_inputs& inputs) {
+    auto c = as_if<constant>(&rhs);
+    if (!c) {
+        return std::nullopt;
+    }
+    const auto rhs_view = get_value_view(*c);
+    const auto lhs_view = rhs_view ? get_value_view(col, inputs) : std::nullopt;
+    if (op == oper_t::EQ || op == oper_t::NEQ) {
+        const bool eq = lhs_view && col.col->type->equal(*lhs_view, *rhs_view);
+        return op == oper_t::EQ ? eq : !eq;
+    }
+    return lhs_view && limits(*lhs_view, op, *rhs_view, col.col->type->without_reversed());
+}
+
 /// True iff the column values are limited by t in the manner prescribed by op.
 bool limits(const tuple_constructor& columns_tuple, const oper_t op, const expression& e,
             const evaluation_inputs& inputs) {
@@ -510,6 +556,11 @@ value_set intersection(value_set a, value_set b, const abstract_type* type) {
 bool is_satisfied_by(const binary_operator& opr, const evaluation_inputs& inputs) {
     return expr::visit(overloaded_functor{
             [&] (const column_value& col) {
+                if (opr.op == oper_t::EQ || opr.op == oper_t::NEQ || is_slice(opr.op)) {
+                    if (auto result = compare_with_constant(col, opr.op, opr.rhs, inputs)) {
+                        return *result;
+                    }
+                }
                 if (opr.op == oper_t::EQ) {
                     return equal(col, opr.rhs, inputs);
                 } else if (opr.op == oper_t::NEQ) {
@@ -1723,6 +1774,36 @@ cql3::raw_value evaluate(const expression& e, const query_options& options) {
     return evaluate(e, evaluation_inputs{.options = &options});
 }
 
+expression fold_constants(const expression& e, const query_options& options) {
+    auto depends_on_row = [] (const expression& sub) {
+        return expr::visit(overloaded_functor{
+            [] (const bind_variable&) { return false; },
+            [] (const constant&) { return false; },
+            [] (const null&) { return false; },
+            [] (const function_call&) { return false; },
+            [] (const cast&) { return false; },
+            [] (const tuple_constructor&) { return false; },
+            [] (const collection_constructor&) { return false; },
+            [] (const usertype_constructor&) { return false; },
+            // Columns, token() and anything evaluate() can't handle.
+            [] (const auto&) { return true; },
+        }, sub);
+    };
+    return search_and_replace(e, [&] (const expression& candidate) -> std::optional<expression> {
+        if (is<constant>(candidate) || is<null>(candidate) || depends_on_row(candidate)
+                || recurse_until(candidate, depends_on_row) || contains_nonpure_function(candidate)) {
+            return std::nullopt;
+        }
+        try {
+            return constant(evaluate(candidate, options), type_of(candidate));
+        } catch (...) {
+            // Leave it in place, so that the error surfaces when the expression
+            // is evaluated, as it would without folding.
+            return std::nullopt;
+        }
+    });
+}
+
 // Takes a value and reserializes it where needs_to_be_reserialized() says it's needed
 template <FragmentedView View>
 static managed_bytes reserialize_value(View value_bytes,
@@ -2073,6 +2154,17 @@ static cql3::raw_value evaluate(const function_call& fun_call, const evaluation_
     arguments.reserve(fun_call.args.size());
 
     for (const expression& arg : fun_call.args) {
+        // Functions take their arguments as bytes, so a column argument has to be
+        // copied once, but not through an intermediate managed_bytes like evaluate() does.
+        if (auto col = as_if<column_value>(&arg)) {
+            auto value = get_value_view(*col, inputs);
+            if (!value) {
+                throw exceptions::invalid_request_exception(format("Invalid null or unset value for argument to {}", *scalar_fun));
+            }
+            arguments.emplace_back(to_bytes(*value));
+            continue;
+        }
+
         cql3::raw_value arg_val = evaluate(arg, inputs);
         if (arg_val.is_null_or_unset()) {
             throw exceptions::invalid_request_exception(format("Invalid null or unset value for argument to {}", *scalar_fun));
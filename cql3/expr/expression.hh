@@ -745,6 +745,13 @@ cql3::raw_value evaluate(const expression& e, const evaluation_inputs&);
 
 cql3::raw_value evaluate(const expression& e, const query_options&);
 
+// Returns a copy of e in which every subexpression whose value doesn't depend on the row
+// (bind variables, calls to pure functions, collection literals, ...) is replaced by a
+// constant holding its value. Evaluating the result for a row gives the same answer as
+// evaluating e, but doesn't redo that work for every row, so filters which are applied
+// to many rows should be folded once per query.
+expression fold_constants(const expression& e, const query_options&);
+
 utils::chunked_vector<managed_bytes> get_list_elements(const cql3::raw_value&);
 utils::chunked_vector<managed_bytes> get_set_elements(const cql3::raw_value&);
 std::vector<managed_bytes_opt> get_tuple_elements(const cql3::raw_value&, const abstract_type& type);
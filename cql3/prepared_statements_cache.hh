@@ -20,9 +20,11 @@ namespace cql3 {
 using prepared_cache_entry = std::unique_ptr<statements::prepared_statement>;
 
 struct prepared_cache_entry_size {
+    // TODO: improve the size approximation
+    static constexpr size_t approximate_size = 10000;
+
     size_t operator()(const prepared_cache_entry& val) {
-        // TODO: improve the size approximation
-        return 10000;
+        return approximate_size;
     }
 };
 
@@ -22,6 +22,7 @@
 #include "db/config.hh"
 #include "data_dictionary/data_dictionary.hh"
 #include "hashers.hh"
+#include "tracing/stage_latencies.hh"
 
 namespace cql3 {
 
@@ -596,10 +597,90 @@ query_processor::get_statement(const sstring_view& query, const service::client_
     return p;
 }
 
+std::unique_ptr<prepared_statement>
+query_processor::get_statement(const sstring_view& query, std::string_view keyspace) {
+    std::unique_ptr<raw::parsed_statement> statement = parse_statement(query);
+
+    auto cf_stmt = dynamic_cast<raw::cf_statement*>(statement.get());
+    if (cf_stmt) {
+        cf_stmt->prepare_keyspace(keyspace);
+    }
+    ++_stats.prepare_invocations;
+    auto p = statement->prepare(_db, _cql_stats);
+    p->statement->raw_cql_statement = sstring(query);
+    return p;
+}
+
+unsigned query_processor::prepared_statement_owner(const prepared_cache_key_type& key) {
+    return std::hash<prepared_cache_key_type>()(key) % smp::count;
+}
+
+future<statements::prepared_statement::checked_weak_ptr>
+query_processor::load_indexed_statement(const prepared_cache_key_type& key, const sstring& query_string, const sstring& keyspace) {
+    return _prepared_cache.get(key, [this, &query_string, &keyspace] {
+        return make_ready_future<std::unique_ptr<statements::prepared_statement>>(get_statement(query_string, keyspace));
+    });
+}
+
+void query_processor::erase_indexed_statement(std::unordered_map<prepared_cache_key_type, prepared_statement_source>::iterator it) {
+    _prepared_statements_index_order.erase(it->second.order_it);
+    _prepared_statements_index.erase(it);
+}
+
+future<> query_processor::index_prepared_statement(sstring query_string, sstring keyspace) {
+    auto key = compute_id(query_string, keyspace);
+    auto owner = prepared_statement_owner(key);
+    return container().invoke_on(owner, [key = std::move(key), query_string = std::move(query_string), keyspace = std::move(keyspace)] (query_processor& qp) mutable {
+        if (qp._prepared_statements_index.contains(key)) {
+            return;
+        }
+        // Prepared outside of the prepared statements cache: the owner shard keeps
+        // the statement only to tell when a schema change invalidates it.
+        auto statement = qp.get_statement(query_string, keyspace)->statement;
+        auto order_it = qp._prepared_statements_index_order.insert(qp._prepared_statements_index_order.end(), key);
+        qp._prepared_statements_index.emplace(std::move(key),
+                prepared_statement_source{std::move(query_string), std::move(keyspace), std::move(statement), order_it});
+
+        const size_t capacity = std::max<size_t>(1, qp._mcfg.prepared_statment_cache_size / prepared_cache_entry_size::approximate_size);
+        while (qp._prepared_statements_index.size() > capacity) {
+            qp.erase_indexed_statement(qp._prepared_statements_index.find(qp._prepared_statements_index_order.front()));
+        }
+    });
+}
+
+future<bool> query_processor::prepare_from_index(prepared_cache_key_type key) {
+    auto owner = prepared_statement_owner(key);
+    return container().invoke_on(owner, [key] (query_processor& qp) -> std::optional<std::pair<sstring, sstring>> {
+        auto it = qp._prepared_statements_index.find(key);
+        if (it == qp._prepared_statements_index.end()) {
+            return std::nullopt;
+        }
+        return std::pair(it->second.query_string, it->second.keyspace);
+    }).then([this, key = std::move(key)] (std::optional<std::pair<sstring, sstring>> source) mutable {
+        if (!source) {
+            return make_ready_future<bool>(false);
+        }
+        return do_with(std::move(key), std::move(*source), [this] (const prepared_cache_key_type& key, std::pair<sstring, sstring>& source) {
+            return load_indexed_statement(key, source.first, source.second).then_wrapped([&key] (future<statements::prepared_statement::checked_weak_ptr> f) {
+                if (f.failed()) {
+                    // The schema may have changed in a way which makes the statement
+                    // invalid. Let the client prepare it again and see the error.
+                    log.debug("Failed to prepare statement {} from the prepared statements index: {}", key, f.get_exception());
+                    return false;
+                }
+                return true;
+            });
+        });
+    });
+}
+
 std::unique_ptr<raw::parsed_statement>
 query_processor::parse_statement(const sstring_view& query) {
+    auto& stage_latencies = tracing::local_stage_latencies();
+    auto start = stage_latencies.maybe_start(tracing::stage::cql_parse);
     try {
         auto statement = util::do_with_parser(query,  std::mem_fn(&cql3_parser::CqlParser::query));
+        stage_latencies.finish(tracing::stage::cql_parse, start);
         if (!statement) {
             throw exceptions::syntax_exception("Parsing failed");
         }
@@ -953,6 +1034,14 @@ void query_processor::migration_subscriber::remove_invalid_prepared_statements(
     _qp->_prepared_cache.remove_if([&] (::shared_ptr<cql_statement> stmt) {
         return this->should_invalidate(ks_name, cf_name, stmt);
     });
+    auto& index = _qp->_prepared_statements_index;
+    for (auto it = index.begin(); it != index.end();) {
+        auto next = std::next(it);
+        if (should_invalidate(ks_name, cf_name, it->second.statement)) {
+            _qp->erase_indexed_statement(it);
+        }
+        it = next;
+    }
 }
 
 bool query_processor::migration_subscriber::should_invalidate(
@@ -10,6 +10,7 @@
 
 #pragma once
 
+#include <list>
 #include <string_view>
 #include <unordered_map>
 
@@ -122,6 +123,24 @@ class query_processor : public seastar::peering_sharded_service<query_processor>
     // don't bother with expiration on those.
     std::unordered_map<sstring, std::unique_ptr<statements::prepared_statement>> _internal_statements;
 
+    // Node-wide index of CQL prepared statements, partitioned across shards by
+    // statement id (see prepared_statement_owner()). It lets a shard prepare a
+    // statement on first use instead of having every PREPARE repeated on all
+    // shards. An entry holds its own reference to the statement, so it does not
+    // depend on the owner shard's cache keeping a statement that is only used
+    // on other shards. Entries are dropped when the statement is invalidated
+    // by a schema change (clients must then prepare it again to learn about the
+    // new metadata), or, oldest first, when the index outgrows the capacity of
+    // the owner shard's prepared statements cache.
+    struct prepared_statement_source {
+        sstring query_string;
+        sstring keyspace;
+        ::shared_ptr<cql_statement> statement;
+        std::list<prepared_cache_key_type>::iterator order_it;
+    };
+    std::unordered_map<prepared_cache_key_type, prepared_statement_source> _prepared_statements_index;
+    std::list<prepared_cache_key_type> _prepared_statements_index_order; // oldest first
+
 public:
     static const sstring CQL_VERSION;
 
@@ -375,6 +394,22 @@ class query_processor : public seastar::peering_sharded_service<query_processor>
             const std::string_view& query,
             const service::client_state& client_state);
 
+    /// \brief Shard which indexes the CQL prepared statement with the given key.
+    static unsigned prepared_statement_owner(const prepared_cache_key_type& key);
+
+    /// \brief Makes a CQL statement prepared on this shard known to the whole node.
+    ///
+    /// Other shards will prepare the statement on first use, see prepare_from_index().
+    /// \param keyspace the raw keyspace of the client which prepared the statement
+    future<> index_prepared_statement(sstring query_string, sstring keyspace);
+
+    /// \brief Prepares a CQL statement on this shard from the node-wide index.
+    ///
+    /// \return false if the statement is not known to the node (it was never prepared,
+    ///         or was evicted or invalidated since), in which case the client must
+    ///         prepare it again.
+    future<bool> prepare_from_index(prepared_cache_key_type key);
+
     friend class migration_subscriber;
 
     shared_ptr<cql_transport::messages::result_message> bounce_to_shard(unsigned shard, cql3::computed_function_values cached_fn_calls);
@@ -384,6 +419,17 @@ class query_processor : public seastar::peering_sharded_service<query_processor>
     void reset_cache();
 
 private:
+    std::unique_ptr<statements::prepared_statement> get_statement(
+            const std::string_view& query,
+            std::string_view keyspace);
+
+    future<statements::prepared_statement::checked_weak_ptr> load_indexed_statement(
+            const prepared_cache_key_type& key,
+            const sstring& query_string,
+            const sstring& keyspace);
+
+    void erase_indexed_statement(std::unordered_map<prepared_cache_key_type, prepared_statement_source>::iterator it);
+
     query_options make_internal_options(
             const statements::prepared_statement::checked_weak_ptr& p,
             const std::initializer_list<data_value>&,
@@ -400,6 +400,15 @@ std::unique_ptr<result_set> result_set_builder::build() {
     return std::move(_result_set);
 }
 
+static expr::single_column_restrictions_map fold_constants(const expr::single_column_restrictions_map& restrictions,
+                                                           const query_options& options) {
+    expr::single_column_restrictions_map folded;
+    for (auto&& [cdef, restriction] : restrictions) {
+        folded.emplace(cdef, expr::fold_constants(restriction, options));
+    }
+    return folded;
+}
+
 result_set_builder::restrictions_filter::restrictions_filter(::shared_ptr<const restrictions::statement_restrictions> restrictions,
         const query_options& options,
         uint64_t remaining,
@@ -411,6 +420,10 @@ result_set_builder::restrictions_filter::restrictions_filter(::shared_ptr<const
     , _options(options)
     , _skip_pk_restrictions(!_restrictions->pk_restrictions_need_filtering())
     , _skip_ck_restrictions(!_restrictions->ck_restrictions_need_filtering())
+    , _clustering_columns_restrictions(expr::fold_constants(_restrictions->get_clustering_columns_restrictions(), options))
+    , _partition_key_restrictions(fold_constants(_restrictions->get_single_column_partition_key_restrictions(), options))
+    , _clustering_key_restrictions(fold_constants(_restrictions->get_single_column_clustering_key_restrictions(), options))
+    , _non_pk_restrictions(fold_constants(_restrictions->get_non_pk_restriction(), options))
     , _remaining(remaining)
     , _schema(schema)
     , _per_partition_limit(per_partition_limit)
@@ -430,17 +443,23 @@ bool result_set_builder::restrictions_filter::do_filter(const selection& selecti
         return false;
     }
 
-    const expr::expression& clustering_columns_restrictions = _restrictions->get_clustering_columns_restrictions();
-    if (expr::contains_multi_column_restriction(clustering_columns_restrictions)) {
+    // Static and regular cell values of this row, collected on first use.
+    std::optional<std::vector<managed_bytes_opt>> static_and_regular_columns;
+    auto get_static_and_regular_columns = [&] () -> const std::vector<managed_bytes_opt>* {
+        if (!static_and_regular_columns) {
+            static_and_regular_columns = expr::get_non_pk_values(selection, static_row, row);
+        }
+        return &*static_and_regular_columns;
+    };
+
+    if (expr::contains_multi_column_restriction(_clustering_columns_restrictions)) {
         clustering_key_prefix ckey = clustering_key_prefix::from_exploded(clustering_key);
-        // FIXME: push to upper layer so it happens once per row
-        auto static_and_regular_columns = expr::get_non_pk_values(selection, static_row, row);
         return expr::is_satisfied_by(
-                clustering_columns_restrictions,
+                _clustering_columns_restrictions,
                 expr::evaluation_inputs{
                     .partition_key = &partition_key,
                     .clustering_key = &clustering_key,
-                    .static_and_regular_columns = &static_and_regular_columns,
+                    .static_and_regular_columns = get_static_and_regular_columns(),
                     .selection = &selection,
                     .options = &_options,
                 });
@@ -448,7 +467,6 @@ bool result_set_builder::restrictions_filter::do_filter(const selection& selecti
 
     auto static_row_iterator = static_row.iterator();
     auto row_iterator = row ? std::optional<query::result_row_view::iterator_type>(row->iterator()) : std::nullopt;
-    const expr::single_column_restrictions_map& non_pk_restrictions_map = _restrictions->get_non_pk_restriction();
     for (auto&& cdef : selection.get_columns()) {
         switch (cdef->kind) {
         case column_kind::static_column:
@@ -457,19 +475,17 @@ bool result_set_builder::restrictions_filter::do_filter(const selection& selecti
             if (cdef->kind == column_kind::regular_column && !row_iterator) {
                 continue;
             }
-            auto restr_it = non_pk_restrictions_map.find(cdef);
-            if (restr_it == non_pk_restrictions_map.end()) {
+            auto restr_it = _non_pk_restrictions.find(cdef);
+            if (restr_it == _non_pk_restrictions.end()) {
                 continue;
             }
             const expr::expression& single_col_restriction = restr_it->second;
-            // FIXME: push to upper layer so it happens once per row
-            auto static_and_regular_columns = expr::get_non_pk_values(selection, static_row, row);
             bool regular_restriction_matches = expr::is_satisfied_by(
                     single_col_restriction,
                     expr::evaluation_inputs{
                         .partition_key = &partition_key,
                         .clustering_key = &clustering_key,
-                        .static_and_regular_columns = &static_and_regular_columns,
+                        .static_and_regular_columns = get_static_and_regular_columns(),
                         .selection = &selection,
                         .options = &_options,
                     });
@@ -483,9 +499,8 @@ bool result_set_builder::restrictions_filter::do_filter(const selection& selecti
             if (_skip_pk_restrictions) {
                 continue;
             }
-            auto partition_key_restrictions_map = _restrictions->get_single_column_partition_key_restrictions();
-            auto restr_it = partition_key_restrictions_map.find(cdef);
-            if (restr_it == partition_key_restrictions_map.end()) {
+            auto restr_it = _partition_key_restrictions.find(cdef);
+            if (restr_it == _partition_key_restrictions.end()) {
                 continue;
             }
             const expr::expression& single_col_restriction = restr_it->second;
@@ -507,10 +522,8 @@ bool result_set_builder::restrictions_filter::do_filter(const selection& selecti
             if (_skip_ck_restrictions) {
                 continue;
             }
-            const expr::single_column_restrictions_map& clustering_key_restrictions_map =
-                _restrictions->get_single_column_clustering_key_restrictions();
-            auto restr_it = clustering_key_restrictions_map.find(cdef);
-            if (restr_it == clustering_key_restrictions_map.end()) {
+            auto restr_it = _clustering_key_restrictions.find(cdef);
+            if (restr_it == _clustering_key_restrictions.end()) {
                 continue;
             }
             if (clustering_key.empty()) {
@@ -15,6 +15,7 @@
 #include "query-result-reader.hh"
 #include "cql3/column_specification.hh"
 #include "cql3/selection/selector.hh"
+#include "cql3/expr/expression.hh"
 #include "exceptions/exceptions.hh"
 #include "unimplemented.hh"
 #include <seastar/core/thread.hh>
@@ -219,6 +220,12 @@ class result_set_builder {
         const query_options& _options;
         const bool _skip_pk_restrictions;
         const bool _skip_ck_restrictions;
+        // Copies of _restrictions with the row-independent parts already evaluated
+        // (see expr::fold_constants()), so that they aren't re-evaluated for every row.
+        const expr::expression _clustering_columns_restrictions;
+        const expr::single_column_restrictions_map _partition_key_restrictions;
+        const expr::single_column_restrictions_map _clustering_key_restrictions;
+        const expr::single_column_restrictions_map _non_pk_restrictions;
         mutable bool _current_partition_key_does_not_match = false;
         mutable bool _current_static_row_does_not_match = false;
         mutable uint64_t _rows_dropped = 0;
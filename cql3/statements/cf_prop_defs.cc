@@ -120,9 +120,13 @@ void cf_prop_defs::validate(const data_dictionary::database db, sstring ks_name,
         cp.validate();
     }
 
-    if (auto caching_options = get_caching_options(); caching_options && !caching_options->enabled() && !db.features().per_table_caching) {
+    auto caching_options = get_caching_options();
+    if (caching_options && !caching_options->enabled() && !db.features().per_table_caching) {
         throw exceptions::configuration_exception(KW_CACHING + " can't contain \"'enabled':false\" unless whole cluster supports it");
     }
+    if (caching_options && caching_options->compressed() && !db.features().cache_compression) {
+        throw exceptions::configuration_exception(KW_CACHING + " can't contain \"'compression'\" unless whole cluster supports it");
+    }
 
     auto cdc_options = get_cdc_options(schema_extensions);
     if (cdc_options && cdc_options->enabled() && !db.features().cdc) {
@@ -801,6 +801,7 @@ db::config::config(std::shared_ptr<db::extensions> exts)
     , experimental(this, "experimental", value_status::Used, false, "[Deprecated] Set to true to unlock all experimental features (except 'raft' feature, which should be enabled explicitly via 'experimental-features' option). Please use 'experimental-features', instead.")
     , experimental_features(this, "experimental_features", value_status::Used, {}, experimental_features_help_string())
     , lsa_reclamation_step(this, "lsa_reclamation_step", value_status::Used, 1, "Minimum number of segments to reclaim in a single step")
+    , lsa_background_defragment_free_segments(this, "lsa_background_defragment_free_segments", value_status::Used, 64, "Number of free LSA segments which are kept available by compacting sparse segments in the background, once no more memory can be given to LSA. This lets allocations avoid compacting memory synchronously. Set to zero to disable background defragmentation")
     , prometheus_port(this, "prometheus_port", value_status::Used, 9180, "Prometheus port, set to zero to disable")
     , prometheus_address(this, "prometheus_address", value_status::Used, {/* listen_address */}, "Prometheus listening address, defaulting to listen_address if not explicitly set")
     , prometheus_prefix(this, "prometheus_prefix", value_status::Used, "scylla", "Set the prefix of the exported Prometheus metrics. Changing this will break Scylla's dashboard compatibility, do not change unless you know what you are doing.")
@@ -838,8 +839,15 @@ db::config::config(std::shared_ptr<db::extensions> exts)
     , max_memory_for_unlimited_query_hard_limit(this, "max_memory_for_unlimited_query_hard_limit", "max_memory_for_unlimited_query", liveness::LiveUpdate, value_status::Used, (uint64_t(100) << 20),
             "Maximum amount of memory a query, whose memory consumption is not naturally limited, is allowed to consume, e.g. non-paged and reverse queries. "
             "This is the hard limit, queries violating this limit will be aborted.")
+    , adaptive_paging_target_latency_in_ms(this, "adaptive_paging_target_latency_in_ms", liveness::LiveUpdate, value_status::Used, 0,
+            "If non-zero, the byte size of the pages of paged queries adapts to how long their previous pages took to fetch: it is halved after pages slower than this, "
+            "and doubled back, up to the default page size, after pages which were cut short by their size but took less than half of this. "
+            "The page size in rows requested by the client is never exceeded.")
     , initial_sstable_loading_concurrency(this, "initial_sstable_loading_concurrency", value_status::Used, 4u,
             "Maximum amount of sstables to load in parallel during initialization. A higher number can lead to more memory consumption. You should not need to touch this")
+    , lazy_load_sstable_bloom_filters(this, "lazy_load_sstable_bloom_filters", value_status::Used, true,
+            "Do not read the bloom filters of sstables while loading them during initialization, but in the background once the node started, starting with the most read tables. "
+            "Reads touch more sstables until the filters are loaded.")
     , enable_3_1_0_compatibility_mode(this, "enable_3_1_0_compatibility_mode", value_status::Used, false,
         "Set to true if the cluster was initially installed from 3.1.0. If it was upgraded from an earlier version,"
         " or installed from a later version, leave this set to false. This adjusts the communication protocol to"
@@ -899,6 +907,8 @@ db::config::config(std::shared_ptr<db::extensions> exts)
         "Ignore truncation record stored in system tables as if tables were never truncated.")
     , force_schema_commit_log(this, "force_schema_commit_log", value_status::Used, false,
         "Use separate schema commit log unconditionally rater than after restart following discovery of cluster-wide support for it.")
+    , raft_group0_max_append_requests_in_flight(this, "raft_group0_max_append_requests_in_flight", value_status::Used, 10,
+        "Maximum number of un-acknowledged append requests which the group 0 leader sends to a follower which keeps up with the log. Raising it helps schema and topology changes to be replicated faster over links with high latency. Must be positive.")
     , default_log_level(this, "default_log_level", value_status::Used)
     , logger_log_level(this, "logger_log_level", value_status::Used)
     , log_to_stdout(this, "log_to_stdout", value_status::Used)
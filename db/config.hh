@@ -309,6 +309,7 @@ class config : public utils::config_file {
     named_value<bool> experimental;
     named_value<std::vector<enum_option<experimental_features_t>>> experimental_features;
     named_value<size_t> lsa_reclamation_step;
+    named_value<size_t> lsa_background_defragment_free_segments;
     named_value<uint16_t> prometheus_port;
     named_value<sstring> prometheus_address;
     named_value<sstring> prometheus_prefix;
@@ -334,7 +335,9 @@ class config : public utils::config_file {
     named_value<uint32_t> max_clustering_key_restrictions_per_query;
     named_value<uint64_t> max_memory_for_unlimited_query_soft_limit;
     named_value<uint64_t> max_memory_for_unlimited_query_hard_limit;
+    named_value<uint32_t> adaptive_paging_target_latency_in_ms;
     named_value<unsigned> initial_sstable_loading_concurrency;
+    named_value<bool> lazy_load_sstable_bloom_filters;
     named_value<bool> enable_3_1_0_compatibility_mode;
     named_value<bool> enable_user_defined_functions;
     named_value<unsigned> user_defined_function_time_limit_ms;
@@ -378,6 +381,7 @@ class config : public utils::config_file {
 
     named_value<bool> ignore_truncation_record;
     named_value<bool> force_schema_commit_log;
+    named_value<size_t> raft_group0_max_append_requests_in_flight;
 
     seastar::logging_settings logging_settings(const log_cli::options&) const;
 
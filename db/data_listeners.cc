@@ -10,6 +10,7 @@
 #include "replica/database.hh"
 #include "readers/filtering.hh"
 #include "db_clock.hh"
+#include "frozen_mutation.hh"
 
 #include <tuple>
 
@@ -114,6 +115,57 @@ toppartitions_data_listener::localize(const global_top_k::results& r) {
     return n;
 }
 
+hot_partitions_tracker::hot_partitions_tracker(data_listeners& listeners)
+        : _listeners(listeners)
+        , _rotate_timer([this] {
+            _previous = std::exchange(_current, window{});
+        }) {
+    _listeners.install(this);
+    _rotate_timer.arm_periodic(window_duration);
+}
+
+hot_partitions_tracker::~hot_partitions_tracker() {
+    _listeners.uninstall(this);
+}
+
+flat_mutation_reader_v2 hot_partitions_tracker::on_read(const schema_ptr& s, const dht::partition_range& range,
+        const query::partition_slice& slice, flat_mutation_reader_v2&& rd) {
+    if (range.is_singular() && range.start()->value().has_key() && sample(_read_countdown)) {
+        try {
+            _current.reads.append(item_key{s->id(), range.start()->value().as_decorated_key()}, sampling_period);
+        } catch (...) {
+            // The sketch is best-effort, it must not fail the read.
+            _current.reads = top_k(capacity);
+        }
+    }
+    return std::move(rd);
+}
+
+void hot_partitions_tracker::on_write(const schema_ptr& s, const frozen_mutation& m) {
+    if (sample(_write_countdown)) {
+        try {
+            _current.writes.append(item_key{s->id(), m.decorated_key(*s)}, sampling_period);
+        } catch (...) {
+            _current.writes = top_k(capacity);
+        }
+    }
+}
+
+hot_partitions_tracker::top_k::results hot_partitions_tracker::merge(const top_k& current, const top_k& previous, unsigned k) {
+    top_k merged(capacity);
+    merged.append(current.top(capacity));
+    merged.append(previous.top(capacity));
+    return merged.top(k);
+}
+
+hot_partitions_tracker::top_k::results hot_partitions_tracker::top_reads(unsigned k) const {
+    return merge(_current.reads, _previous.reads, k);
+}
+
+hot_partitions_tracker::top_k::results hot_partitions_tracker::top_writes(unsigned k) const {
+    return merge(_current.writes, _previous.writes, k);
+}
+
 toppartitions_query::toppartitions_query(distributed<replica::database>& xdb, std::unordered_set<std::tuple<sstring, sstring>, utils::tuple_hash>&& table_filters,
         std::unordered_set<sstring>&& keyspace_filters, std::chrono::milliseconds duration, size_t list_size, size_t capacity)
         : _xdb(xdb), _table_filters(std::move(table_filters)), _keyspace_filters(std::move(keyspace_filters)), _duration(duration), _list_size(list_size), _capacity(capacity),
@@ -12,8 +12,11 @@
 #include <seastar/core/future.hh>
 #include <seastar/core/distributed.hh>
 #include <seastar/core/weak_ptr.hh>
+#include <seastar/core/timer.hh>
+#include <seastar/core/lowres_clock.hh>
 
 #include "utils/hash.hh"
+#include "utils/UUID.hh"
 #include "schema_fwd.hh"
 #include "readers/flat_mutation_reader_v2.hh"
 #include "utils/top_k.hh"
@@ -138,6 +141,77 @@ class toppartitions_data_listener : public data_listener, public weakly_referenc
     future<> stop();
 };
 
+// Continuously tracks the most frequently read and written partitions of
+// all tables on this shard, to find hot partitions without having to start
+// a toppartitions query first.
+//
+// Unlike toppartitions_data_listener, it is always installed, so it only
+// samples one in every sampling_period operations, counting it as
+// sampling_period operations, and only looks at single-partition reads.
+// Keys are tracked by table id rather than by schema, so they don't keep
+// the schemas of dropped tables alive.
+// Counts are kept in two windows of window_duration: the current one and
+// the previous one, so partitions which cool down age out.
+class hot_partitions_tracker : public data_listener {
+public:
+    struct item_key {
+        utils::UUID table_id;
+        dht::decorated_key key;
+
+        struct hash {
+            size_t operator()(const item_key& k) const {
+                return std::hash<dht::token>()(k.key.token());
+            }
+        };
+
+        struct comp {
+            bool operator()(const item_key& k1, const item_key& k2) const {
+                return k1.table_id == k2.table_id && k1.key.token() == k2.key.token()
+                        && k1.key.key().representation() == k2.key.key().representation();
+            }
+        };
+    };
+
+    using top_k = utils::space_saving_top_k<item_key, item_key::hash, item_key::comp>;
+
+    static constexpr size_t capacity = 256;
+    static constexpr unsigned sampling_period = 8;
+    static constexpr std::chrono::seconds window_duration{60};
+
+private:
+    struct window {
+        top_k reads{capacity};
+        top_k writes{capacity};
+    };
+
+    data_listeners& _listeners;
+    window _current;
+    window _previous;
+    unsigned _read_countdown = sampling_period;
+    unsigned _write_countdown = sampling_period;
+    timer<lowres_clock> _rotate_timer;
+
+    static bool sample(unsigned& countdown) noexcept {
+        if (--countdown) {
+            return false;
+        }
+        countdown = sampling_period;
+        return true;
+    }
+    static top_k::results merge(const top_k& current, const top_k& previous, unsigned k);
+public:
+    explicit hot_partitions_tracker(data_listeners& listeners);
+    ~hot_partitions_tracker();
+
+    virtual flat_mutation_reader_v2 on_read(const schema_ptr& s, const dht::partition_range& range,
+            const query::partition_slice& slice, flat_mutation_reader_v2&& rd) override;
+
+    virtual void on_write(const schema_ptr& s, const frozen_mutation& m) override;
+
+    top_k::results top_reads(unsigned k) const;
+    top_k::results top_writes(unsigned k) const;
+};
+
 class toppartitions_query {
     distributed<replica::database>& _xdb;
     std::unordered_set<std::tuple<sstring, sstring>, utils::tuple_hash> _table_filters;
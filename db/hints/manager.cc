@@ -21,6 +21,7 @@
 #include "service/storage_proxy.hh"
 #include "gms/versioned_value.hh"
 #include "gms/gossiper.hh"
+#include "gms/feature_service.hh"
 #include "seastarx.hh"
 #include "converting_mutation_partition_applier.hh"
 #include "utils/disk-error-handler.hh"
@@ -855,59 +856,75 @@ future<> manager::end_point_hints_manager::sender::send_one_mutation(frozen_muta
     return do_send_one_mutation(std::move(m), natural_endpoints);
 }
 
+std::optional<frozen_mutation_and_schema> manager::end_point_hints_manager::sender::get_mutation_to_send(lw_shared_ptr<send_one_file_ctx> ctx_ptr, fragmented_temporary_buffer& buf, db::replay_position rp, gc_clock::duration secs_since_file_mod, const sstring& fname) {
+    try {
+        auto m = this->get_mutation(ctx_ptr, buf);
+        gc_clock::duration gc_grace_sec = m.s->gc_grace_seconds();
+
+        // The hint is too old - drop it.
+        //
+        // Files are aggregated for at most manager::hints_timer_period therefore the oldest hint there is
+        // (last_modification - manager::hints_timer_period) old.
+        if (gc_clock::now().time_since_epoch() - secs_since_file_mod > gc_grace_sec - manager::hints_flush_period) {
+            return std::nullopt;
+        }
+        return m;
+
+    // ignore these errors and move on - probably this hint is too old and the KS/CF has been deleted...
+    } catch (replica::no_such_column_family& e) {
+        manager_logger.debug("send_hints(): no_such_column_family: {}", e.what());
+        ++this->shard_stats().discarded;
+    } catch (replica::no_such_keyspace& e) {
+        manager_logger.debug("send_hints(): no_such_keyspace: {}", e.what());
+        ++this->shard_stats().discarded;
+    } catch (no_column_mapping& e) {
+        manager_logger.debug("send_hints(): {} at {}: {}", fname, rp, e.what());
+        ++this->shard_stats().discarded;
+    } catch (...) {
+        manager_logger.debug("send_hints(): unexpected error in file {} at {}: {}", fname, rp, std::current_exception());
+        throw;
+    }
+    return std::nullopt;
+}
+
+void manager::end_point_hints_manager::sender::on_hint_sent(send_one_file_ctx& ctx, db::replay_position rp) noexcept {
+    ctx.on_hint_send_success(rp);
+    auto new_bound = ctx.get_replayed_bound();
+    // Segments from other shards are replayed first and are considered to be "before" replay position 0.
+    // Update the sent upper bound only if it is a local segment.
+    if (new_bound.shard_id() == this_shard_id() && _sent_upper_bound_rp < new_bound) {
+        _sent_upper_bound_rp = new_bound;
+        notify_replay_waiters();
+    }
+}
+
 future<> manager::end_point_hints_manager::sender::send_one_hint(lw_shared_ptr<send_one_file_ctx> ctx_ptr, fragmented_temporary_buffer buf, db::replay_position rp, gc_clock::duration secs_since_file_mod, const sstring& fname) {
     return _resource_manager.get_send_units_for(buf.size_bytes()).then([this, secs_since_file_mod, &fname, buf = std::move(buf), rp, ctx_ptr] (auto units) mutable {
         ctx_ptr->mark_hint_as_in_progress(rp);
 
         // Future is waited on indirectly in `send_one_file()` (via `ctx_ptr->file_send_gate`).
         (void)with_gate(ctx_ptr->file_send_gate, [this, secs_since_file_mod, &fname, buf = std::move(buf), rp, ctx_ptr] () mutable {
+            std::optional<frozen_mutation_and_schema> m;
             try {
-                auto m = this->get_mutation(ctx_ptr, buf);
-                gc_clock::duration gc_grace_sec = m.s->gc_grace_seconds();
-
-                // The hint is too old - drop it.
-                //
-                // Files are aggregated for at most manager::hints_timer_period therefore the oldest hint there is
-                // (last_modification - manager::hints_timer_period) old.
-                if (gc_clock::now().time_since_epoch() - secs_since_file_mod > gc_grace_sec - manager::hints_flush_period) {
-                    return make_ready_future<>();
-                }
-
-                return this->send_one_mutation(std::move(m)).then([this, rp, ctx_ptr] {
-                    ++this->shard_stats().sent;
-                }).handle_exception([this, ctx_ptr, rp] (auto eptr) {
-                    manager_logger.trace("send_one_hint(): failed to send to {}: {}", end_point_key(), eptr);
-                    return make_exception_future<>(std::move(eptr));
-                });
-
-            // ignore these errors and move on - probably this hint is too old and the KS/CF has been deleted...
-            } catch (replica::no_such_column_family& e) {
-                manager_logger.debug("send_hints(): no_such_column_family: {}", e.what());
-                ++this->shard_stats().discarded;
-            } catch (replica::no_such_keyspace& e) {
-                manager_logger.debug("send_hints(): no_such_keyspace: {}", e.what());
-                ++this->shard_stats().discarded;
-            } catch (no_column_mapping& e) {
-                manager_logger.debug("send_hints(): {} at {}: {}", fname, rp, e.what());
-                ++this->shard_stats().discarded;
+                m = this->get_mutation_to_send(ctx_ptr, buf, rp, secs_since_file_mod, fname);
             } catch (...) {
-                auto eptr = std::current_exception();
-                manager_logger.debug("send_hints(): unexpected error in file {} at {}: {}", fname, rp, eptr);
-                return make_exception_future<>(std::move(eptr));
+                return current_exception_as_future();
             }
-            return make_ready_future<>();
+            if (!m) {
+                return make_ready_future<>();
+            }
+
+            return this->send_one_mutation(std::move(*m)).then([this, rp, ctx_ptr] {
+                ++this->shard_stats().sent;
+            }).handle_exception([this, ctx_ptr, rp] (auto eptr) {
+                manager_logger.trace("send_one_hint(): failed to send to {}: {}", end_point_key(), eptr);
+                return make_exception_future<>(std::move(eptr));
+            });
         }).then_wrapped([this, units = std::move(units), rp, ctx_ptr] (future<>&& f) {
             // Information about the error was already printed somewhere higher.
             // We just need to account in the ctx that sending of this hint has failed.
             if (!f.failed()) {
-                ctx_ptr->on_hint_send_success(rp);
-                auto new_bound = ctx_ptr->get_replayed_bound();
-                // Segments from other shards are replayed first and are considered to be "before" replay position 0.
-                // Update the sent upper bound only if it is a local segment.
-                if (new_bound.shard_id() == this_shard_id() && _sent_upper_bound_rp < new_bound) {
-                    _sent_upper_bound_rp = new_bound;
-                    notify_replay_waiters();
-                }
+                on_hint_sent(*ctx_ptr, rp);
             } else {
                 ctx_ptr->on_hint_send_failure(rp);
             }
@@ -919,6 +936,112 @@ future<> manager::end_point_hints_manager::sender::send_one_hint(lw_shared_ptr<s
     });
 }
 
+bool manager::end_point_hints_manager::sender::batching_allowed() const noexcept {
+    return _proxy.features().hint_mutation_batch;
+}
+
+future<> manager::end_point_hints_manager::sender::add_hint_to_batch(lw_shared_ptr<send_one_file_ctx> ctx_ptr, fragmented_temporary_buffer buf, db::replay_position rp, gc_clock::duration secs_since_file_mod, const sstring& fname) {
+    if (!ctx_ptr->add_to_batch(std::move(buf), rp)) {
+        return make_ready_future<>();
+    }
+    return send_hint_batch(std::move(ctx_ptr), secs_since_file_mod, fname);
+}
+
+future<> manager::end_point_hints_manager::sender::send_hint_batch(lw_shared_ptr<send_one_file_ctx> ctx_ptr, gc_clock::duration secs_since_file_mod, const sstring& fname) {
+    auto size = ctx_ptr->batch_size;
+    auto hints = ctx_ptr->take_batch();
+    if (hints.empty()) {
+        co_return;
+    }
+    // The hints were already marked as in progress, so they must either be sent or marked as failed.
+    if ((!draining() && ctx_ptr->segment_replay_failed) || !can_send()) {
+        for (auto& h : hints) {
+            ctx_ptr->on_hint_send_failure(h.rp);
+        }
+        co_return;
+    }
+    try {
+        auto units = co_await _resource_manager.get_send_units_for(size);
+        // Future is waited on indirectly in `send_one_file()` (via `ctx_ptr->file_send_gate`).
+        (void)with_gate(ctx_ptr->file_send_gate, [this, ctx_ptr, &hints, secs_since_file_mod, &fname, units = std::move(units)] () mutable {
+            return do_send_hint_batch(ctx_ptr, std::move(hints), secs_since_file_mod, fname).finally([units = std::move(units)] {});
+        });
+    } catch (...) {
+        manager_logger.trace("send_one_file(): Hmmm. Something bad had happend: {}", std::current_exception());
+        for (auto& h : hints) {
+            ctx_ptr->on_hint_send_failure(h.rp);
+        }
+    }
+}
+
+future<> manager::end_point_hints_manager::sender::do_send_hint_batch(lw_shared_ptr<send_one_file_ctx> ctx_ptr, std::vector<pending_hint> hints, gc_clock::duration secs_since_file_mod, const sstring& fname) {
+    struct hint_to_send {
+        frozen_mutation_and_schema m;
+        dht::token token;
+        db::replay_position rp;
+    };
+    std::vector<hint_to_send> to_send;
+    to_send.reserve(hints.size());
+    for (auto& h : hints) {
+        try {
+            if (auto m = get_mutation_to_send(ctx_ptr, h.buf, h.rp, secs_since_file_mod, fname)) {
+                auto token = dht::get_token(*m->s, m->fm.key());
+                to_send.push_back(hint_to_send{std::move(*m), std::move(token), h.rp});
+            } else {
+                on_hint_sent(*ctx_ptr, h.rp);
+            }
+        } catch (...) {
+            ctx_ptr->on_hint_send_failure(h.rp);
+        }
+    }
+    hints = {};
+
+    // Let the receiver apply the mutations in ring order.
+    std::sort(to_send.begin(), to_send.end(), [] (const hint_to_send& a, const hint_to_send& b) {
+        return a.token < b.token;
+    });
+
+    std::vector<frozen_mutation_and_schema> batch;
+    std::vector<db::replay_position> batch_rps;
+    for (auto& h : to_send) {
+        try {
+            replica::keyspace& ks = _db.find_keyspace(h.m.s->ks_name());
+            auto natural_endpoints = ks.get_effective_replication_map()->get_natural_endpoints(h.token);
+            if (boost::range::find(natural_endpoints, end_point_key()) != natural_endpoints.end()) {
+                batch.push_back(std::move(h.m));
+                batch_rps.push_back(h.rp);
+                continue;
+            }
+            // The destination is no longer a replica - send it like a single hint, to all current replicas.
+            co_await do_send_one_mutation(std::move(h.m), natural_endpoints);
+            ++shard_stats().sent;
+            on_hint_sent(*ctx_ptr, h.rp);
+        } catch (...) {
+            manager_logger.trace("send_hint_batch(): failed to send to {}: {}", end_point_key(), std::current_exception());
+            ctx_ptr->on_hint_send_failure(h.rp);
+        }
+    }
+    if (batch.empty()) {
+        co_return;
+    }
+
+    std::exception_ptr ex;
+    try {
+        co_await _proxy.send_hint_batch_to_endpoint(std::move(batch), end_point_key());
+    } catch (...) {
+        ex = std::current_exception();
+        manager_logger.trace("send_hint_batch(): failed to send {} hints to {}: {}", batch_rps.size(), end_point_key(), ex);
+    }
+    for (auto rp : batch_rps) {
+        if (ex) {
+            ctx_ptr->on_hint_send_failure(rp);
+        } else {
+            ++shard_stats().sent;
+            on_hint_sent(*ctx_ptr, rp);
+        }
+    }
+}
+
 void manager::end_point_hints_manager::sender::notify_replay_waiters() noexcept {
     if (!_foreign_segments_to_replay.empty()) {
         manager_logger.trace("[{}] notify_replay_waiters(): not notifying because there are still {} foreign segments to replay", end_point_key(), _foreign_segments_to_replay.size());
@@ -996,6 +1119,18 @@ void manager::end_point_hints_manager::sender::send_one_file_ctx::on_hint_send_f
     }
 }
 
+bool manager::end_point_hints_manager::sender::send_one_file_ctx::add_to_batch(fragmented_temporary_buffer buf, db::replay_position rp) {
+    mark_hint_as_in_progress(rp);
+    batch_size += buf.size_bytes();
+    batch.push_back(pending_hint{std::move(buf), rp});
+    return batch.size() >= max_hints_per_batch || batch_size >= max_hint_batch_size;
+}
+
+std::vector<manager::end_point_hints_manager::sender::pending_hint> manager::end_point_hints_manager::sender::send_one_file_ctx::take_batch() noexcept {
+    batch_size = 0;
+    return std::exchange(batch, {});
+}
+
 db::replay_position manager::end_point_hints_manager::sender::send_one_file_ctx::get_replayed_bound() const noexcept {
     // We are sure that all hints were sent _below_ the position which is the minimum of the following:
     // - Position of the first hint that failed to be sent in this replay (first_failed_rp),
@@ -1019,6 +1154,10 @@ db::replay_position manager::end_point_hints_manager::sender::send_one_file_ctx:
     return rp;
 }
 
+db::replay_position manager::end_point_hints_manager::sender::send_one_file_ctx::get_retry_position(db::replay_position replay_start) const noexcept {
+    return first_failed_rp.value_or(last_succeeded_rp.value_or(replay_start));
+}
+
 void manager::end_point_hints_manager::sender::rewind_sent_replay_position_to(db::replay_position rp) {
     _sent_upper_bound_rp = rp;
     notify_replay_waiters();
@@ -1062,6 +1201,9 @@ bool manager::end_point_hints_manager::sender::send_one_file(const sstring& fnam
                     //   hints in a segment".
                     co_await sleep(std::chrono::milliseconds(100));
                     continue;
+                } else if (batching_allowed()) {
+                    co_await add_hint_to_batch(ctx_ptr, std::move(buf), rp, secs_since_file_mod, fname);
+                    break;
                 } else {
                     co_await send_one_hint(ctx_ptr, std::move(buf), rp, secs_since_file_mod, fname);
                     break;
@@ -1077,6 +1219,9 @@ bool manager::end_point_hints_manager::sender::send_one_file(const sstring& fnam
         ctx_ptr->segment_replay_failed = true;
     }
 
+    // send the hints which didn't fill a whole batch
+    send_hint_batch(ctx_ptr, secs_since_file_mod, fname).get();
+
     // wait till all background hints sending is complete
     ctx_ptr->file_send_gate.close().get();
 
@@ -1091,7 +1236,7 @@ bool manager::end_point_hints_manager::sender::send_one_file(const sstring& fnam
         // If some hints failed to be sent, first_failed_rp will tell the position of first such hint.
         // If there was an error thrown by read_log_file function itself, we will retry sending from
         // the last hint that was successfully sent (last_succeeded_rp).
-        _last_not_complete_rp = ctx_ptr->first_failed_rp.value_or(ctx_ptr->last_succeeded_rp.value_or(_last_not_complete_rp));
+        _last_not_complete_rp = ctx_ptr->get_retry_position(_last_not_complete_rp);
         manager_logger.trace("send_one_file(): error while sending hints from {}, last RP is {}", fname, _last_not_complete_rp);
         return false;
     }
@@ -29,6 +29,7 @@
 #include "db/hints/sync_point.hh"
 
 class fragmented_temporary_buffer;
+class hint_sender_test;
 
 namespace utils {
 class directories;
@@ -108,6 +109,14 @@ class manager {
                 state::ep_state_left_the_ring,
                 state::draining>>;
 
+            friend class ::hint_sender_test;
+
+            // A hint read from a segment and waiting to be sent as a part of a batch.
+            struct pending_hint {
+                fragmented_temporary_buffer buf;
+                db::replay_position rp;
+            };
+
             struct send_one_file_ctx {
                 send_one_file_ctx(std::unordered_map<table_schema_version, column_mapping>& last_schema_ver_to_column_mapping)
                     : schema_ver_to_column_mapping(last_schema_ver_to_column_mapping)
@@ -118,16 +127,28 @@ class manager {
                 std::optional<db::replay_position> last_succeeded_rp;
                 std::set<db::replay_position> in_progress_rps;
                 bool segment_replay_failed = false;
+                // Hints collected for the next HINT_MUTATION_BATCH RPC, see add_hint_to_batch().
+                std::vector<pending_hint> batch;
+                size_t batch_size = 0;
 
                 void mark_hint_as_in_progress(db::replay_position rp);
                 void on_hint_send_success(db::replay_position rp) noexcept;
                 void on_hint_send_failure(db::replay_position rp) noexcept;
 
+                // Queues a hint for the next batch and marks it as in progress.
+                // Returns true if the batch is full and has to be sent.
+                bool add_to_batch(fragmented_temporary_buffer buf, db::replay_position rp);
+                // Returns the queued hints, leaving the batch empty.
+                std::vector<pending_hint> take_batch() noexcept;
+
                 // Returns a position below which hints were successfully replayed.
                 db::replay_position get_replayed_bound() const noexcept;
+
+                // Returns the position from which a segment which failed to be replayed
+                // is replayed again, given the one from which this replay started.
+                db::replay_position get_retry_position(db::replay_position replay_start) const noexcept;
             };
 
-        private:
             std::list<sstring> _segments_to_replay;
             // Segments to replay which were not created on this shard but were moved during rebalancing
             std::list<sstring> _foreign_segments_to_replay;
@@ -151,6 +172,10 @@ class manager {
 
             std::multimap<db::replay_position, lw_shared_ptr<std::optional<promise<>>>> _replay_waiters;
 
+            // Limits on the number and the total size of hints sent in a single HINT_MUTATION_BATCH RPC.
+            static constexpr size_t max_hints_per_batch = 128;
+            static constexpr size_t max_hint_batch_size = 256 * 1024;
+
         public:
             sender(end_point_hints_manager& parent, service::storage_proxy& local_storage_proxy, replica::database& local_db, gms::gossiper& local_gossiper) noexcept;
             ~sender();
@@ -244,6 +269,35 @@ class manager {
             /// \return future that resolves when next hint may be sent
             future<> send_one_hint(lw_shared_ptr<send_one_file_ctx> ctx_ptr, fragmented_temporary_buffer buf, db::replay_position rp, gc_clock::duration secs_since_file_mod, const sstring& fname);
 
+            /// \brief Checks if hints can be sent in batches, with a single RPC for many hints.
+            bool batching_allowed() const noexcept;
+
+            /// \brief Queue one hint read from the file to be sent as a part of a batch.
+            ///
+            /// The batch is sent once it reaches max_hints_per_batch hints or max_hint_batch_size bytes.
+            /// The parameters are the same as for send_one_hint().
+            ///
+            /// \return future that resolves when next hint may be read
+            future<> add_hint_to_batch(lw_shared_ptr<send_one_file_ctx> ctx_ptr, fragmented_temporary_buffer buf, db::replay_position rp, gc_clock::duration secs_since_file_mod, const sstring& fname);
+
+            /// \brief Send the hints queued by add_hint_to_batch().
+            ///
+            /// The memory of the whole batch is reserved at once, after which the batch is sent in the background,
+            /// like send_one_hint() does for a single hint.
+            ///
+            /// \return future that resolves when next hint may be read
+            future<> send_hint_batch(lw_shared_ptr<send_one_file_ctx> ctx_ptr, gc_clock::duration secs_since_file_mod, const sstring& fname);
+
+            /// \brief Sends the given hints sorted by token.
+            ///
+            /// Hints for which the destination node is still a replica are sent with a single HINT_MUTATION_BATCH RPC,
+            /// the remaining ones are sent one by one, to all their current replicas.
+            /// Never fails: the outcome for each hint is recorded in \ref ctx_ptr.
+            future<> do_send_hint_batch(lw_shared_ptr<send_one_file_ctx> ctx_ptr, std::vector<pending_hint> hints, gc_clock::duration secs_since_file_mod, const sstring& fname);
+
+            /// \brief Accounts a hint that was sent (or dropped because it didn't need to be sent).
+            void on_hint_sent(send_one_file_ctx& ctx, db::replay_position rp) noexcept;
+
             /// \brief Send all hint from a single file and delete it after it has been successfully sent.
             /// Send all hints from the given file. If we failed to send the current segment we will pick up in the next
             /// iteration from where we left in this one.
@@ -262,6 +316,13 @@ class manager {
             /// \return The mutation object representing the original mutation stored in the hints file.
             frozen_mutation_and_schema get_mutation(lw_shared_ptr<send_one_file_ctx> ctx_ptr, fragmented_temporary_buffer& buf);
 
+            /// \brief Restore the mutation from the hints file entry, unless the hint should be dropped.
+            ///
+            /// A hint is dropped if it is older than gc_grace_seconds of its table, or if its table (or the column
+            /// mapping needed to decode it) no longer exists.
+            /// \return The mutation to send, or std::nullopt if the hint should be dropped.
+            std::optional<frozen_mutation_and_schema> get_mutation_to_send(lw_shared_ptr<send_one_file_ctx> ctx_ptr, fragmented_temporary_buffer& buf, db::replay_position rp, gc_clock::duration secs_since_file_mod, const sstring& fname);
+
             /// \brief Get a reference to the column_mapping object for a given frozen mutation.
             /// \param ctx_ptr pointer to the send context
             /// \param fm Frozen mutation object
@@ -918,9 +918,133 @@ static future<> with_merge_lock(noncopyable_function<future<> ()> func) {
     }
 }
 
+namespace {
+
+// Feeds calculate_schema_digest() the bytes fed into a hasher before.
+struct recording_hasher : public hasher {
+    bytes_ostream out;
+    void update(const char* ptr, size_t size) noexcept override {
+        out.write(bytes_view(reinterpret_cast<const bytes::value_type*>(ptr), size));
+    }
+};
+
+// Remembers what calculate_schema_digest() feeds into the digest for every
+// partition of the schema tables, so that after a merge only the partitions
+// of the merged keyspaces are read and hashed again, rather than the schema
+// of every table in the cluster. The digest is the same as the one computed
+// from scratch, so nodes with and without the cache agree on schema versions.
+//
+// Only used on shard 0, under the merge lock. Tables are digested in the order
+// of all_table_names() and their partitions in ring order, like query_mutations()
+// returns them.
+class schema_digest_cache {
+    using partitions = std::map<dht::decorated_key, bytes_ostream, dht::decorated_key::less_comparator>;
+    std::optional<schema_features> _features;
+    std::unordered_map<sstring, partitions> _tables;
+    std::set<sstring> _stale_keyspaces;
+public:
+    void invalidate() {
+        _features.reset();
+        _tables.clear();
+        _stale_keyspaces.clear();
+    }
+
+    void invalidate(const std::set<sstring>& keyspaces) {
+        if (_features) {
+            _stale_keyspaces.insert(keyspaces.begin(), keyspaces.end());
+        }
+    }
+
+    future<utils::UUID> digest(distributed<service::storage_proxy>& proxy, schema_features features) {
+        // Without DIGEST_INSENSITIVE_TO_EXPIRY, partitions which contain only
+        // tombstones are fed into the digest, and telling them apart from
+        // missing partitions would need a range scan anyway.
+        if (!features.contains<schema_feature::DIGEST_INSENSITIVE_TO_EXPIRY>()) {
+            invalidate();
+            co_return co_await calculate_schema_digest(proxy, features);
+        }
+        if (!_features || _features->mask() != features.mask()) {
+            co_await load(proxy, features);
+        } else {
+            co_await refresh(proxy, features);
+        }
+        auto hash = md5_hasher();
+        for (auto& table : all_table_names(features)) {
+            for (auto& [dk, fed] : _tables[table]) {
+                for (bytes_view frag : fed) {
+                    hash.update(reinterpret_cast<const char*>(frag.data()), frag.size());
+                }
+            }
+            co_await coroutine::maybe_yield();
+        }
+        co_return utils::UUID_gen::get_name_UUID(hash.finalize());
+    }
+private:
+    future<> load(distributed<service::storage_proxy>& proxy, schema_features features) {
+        invalidate();
+        for (auto& table : all_table_names(features)) {
+            auto s = proxy.local().get_db().local().find_schema(NAME, table);
+            auto rs = co_await db::system_keyspace::query_mutations(proxy, NAME, table);
+            auto& entries = _tables.emplace(table, partitions(dht::decorated_key::less_comparator(s))).first->second;
+            for (auto&& p : rs->partitions()) {
+                auto mut = p.mut().unfreeze(s);
+                auto keyspace_name = value_cast<sstring>(utf8_type->deserialize(mut.key().get_component(*s, 0)));
+                if (!is_system_keyspace(keyspace_name)) {
+                    add(entries, std::move(mut), features);
+                }
+                co_await coroutine::maybe_yield();
+            }
+        }
+        _features = features;
+    }
+
+    future<> refresh(distributed<service::storage_proxy>& proxy, schema_features features) {
+        auto keyspaces = std::exchange(_stale_keyspaces, {});
+        try {
+            for (auto& keyspace_name : keyspaces) {
+                if (is_system_keyspace(keyspace_name)) {
+                    continue;
+                }
+                for (auto& table : all_table_names(features)) {
+                    auto s = proxy.local().get_db().local().find_schema(NAME, table);
+                    auto key = partition_key::from_singular(*s, keyspace_name);
+                    auto slice = s->full_slice();
+                    auto cmd = make_lw_shared<query::read_command>(s->id(), s->version(), std::move(slice), proxy.local().get_max_result_size(slice));
+                    auto mut = co_await query_partition_mutation(proxy.local(), s, std::move(cmd), std::move(key));
+                    auto& entries = _tables.at(table);
+                    entries.erase(mut.decorated_key());
+                    add(entries, std::move(mut), features);
+                }
+            }
+        } catch (...) {
+            invalidate();
+            throw;
+        }
+    }
+
+    static void add(partitions& entries, mutation mut, schema_features features) {
+        auto dk = mut.decorated_key();
+        mut = redact_columns_for_missing_features(std::move(mut), features);
+        recording_hasher h;
+        feed_hash_for_schema_digest(h, mut, features);
+        if (h.out.size()) {
+            entries.emplace(std::move(dk), std::move(h.out));
+        }
+    }
+};
+
+}
+
+static thread_local schema_digest_cache the_schema_digest_cache;
+
 static
 future<> update_schema_version_and_announce(sharded<db::system_keyspace>& sys_ks, distributed<service::storage_proxy>& proxy, schema_features features) {
-    auto uuid = co_await calculate_schema_digest(proxy, features);
+    utils::UUID uuid;
+    if (this_shard_id() == 0) {
+        uuid = co_await the_schema_digest_cache.digest(proxy, features);
+    } else {
+        uuid = co_await calculate_schema_digest(proxy, features);
+    }
     co_await sys_ks.local().update_schema_version(uuid);
     co_await proxy.local().get_db().invoke_on_all([uuid] (replica::database& db) {
         db.update_version(uuid);
@@ -955,6 +1079,9 @@ future<> merge_schema(sharded<db::system_keyspace>& sys_ks, distributed<service:
 
 future<> recalculate_schema_version(sharded<db::system_keyspace>& sys_ks, distributed<service::storage_proxy>& proxy, gms::feature_service& feat) {
     co_await with_merge_lock([&] () -> future<> {
+        co_await smp::submit_to(0, [] {
+            the_schema_digest_cache.invalidate();
+        });
         co_await update_schema_version_and_announce(sys_ks, proxy, feat.cluster_schema_features());
     });
 }
@@ -1098,6 +1225,7 @@ static future<> do_merge_schema(distributed<service::storage_proxy>& proxy, std:
         // schema may be a mix of the old and new schemas.
         delete_schema_version(mutation);
     }
+    the_schema_digest_cache.invalidate(keyspaces);
 
     // current state of the schema
     auto&& old_keyspaces = co_await read_schema_for_keyspaces(proxy, KEYSPACES, keyspaces);
@@ -59,6 +59,8 @@
 #include "gms/gossiper.hh"
 #include "service/paxos/paxos_state.hh"
 #include "utils/build_id.hh"
+#include "tracing/stage_latencies.hh"
+#include "db/data_listeners.hh"
 #include "query-result-set.hh"
 #include "idl/frozen_mutation.dist.hh"
 #include "serializer_impl.hh"
@@ -2161,6 +2163,131 @@ class protocol_servers_table : public memtable_filling_virtual_table {
     }
 };
 
+class hot_partitions_table : public memtable_filling_virtual_table {
+    distributed<replica::database>& _db;
+
+    using top_k = hot_partitions_tracker::top_k;
+    using shard_results = std::pair<top_k::results, top_k::results>;
+public:
+    explicit hot_partitions_table(distributed<replica::database>& db)
+        : memtable_filling_virtual_table(build_schema())
+        , _db(db) {
+        _shard_aware = true;
+    }
+
+    static schema_ptr build_schema() {
+        auto id = generate_legacy_id(system_keyspace::NAME, "hot_partitions");
+        return schema_builder(system_keyspace::NAME, "hot_partitions", std::make_optional(id))
+            .with_column("keyspace_name", utf8_type, column_kind::partition_key)
+            .with_column("table_name", utf8_type, column_kind::clustering_key)
+            .with_column("operation", utf8_type, column_kind::clustering_key)
+            .with_column("partition_key", utf8_type, column_kind::clustering_key)
+            .with_column("count", long_type)
+            .with_column("error", long_type)
+            .set_comment("The most frequently read and written partitions of this node, estimated from sampled operations.")
+            .with_version(system_keyspace::generate_schema_version(id))
+            .build();
+    }
+
+    future<> execute(std::function<void(mutation)> mutation_sink) override {
+        top_k reads(hot_partitions_tracker::capacity);
+        top_k writes(hot_partitions_tracker::capacity);
+        for (unsigned shard = 0; shard < smp::count; ++shard) {
+            auto res = co_await _db.invoke_on(shard, [] (replica::database& db) {
+                const auto& hp = db.hot_partitions();
+                return make_foreign(std::make_unique<shard_results>(hp.top_reads(hot_partitions_tracker::capacity),
+                        hp.top_writes(hot_partitions_tracker::capacity)));
+            });
+            // The keys are copied to this shard by append().
+            reads.append(res->first);
+            writes.append(res->second);
+        }
+
+        std::map<sstring, mutation> partitions;
+        auto add_rows = [&] (const top_k& top, const sstring& operation) {
+            for (auto& r : top.top(hot_partitions_tracker::capacity)) {
+                schema_ptr table_schema;
+                try {
+                    table_schema = _db.local().find_schema(r.item.table_id);
+                } catch (replica::no_such_column_family&) {
+                    continue;
+                }
+                auto it = partitions.find(table_schema->ks_name());
+                if (it == partitions.end()) {
+                    auto dk = dht::decorate_key(*_s, partition_key::from_single_value(*schema(), data_value(table_schema->ks_name()).serialize_nonnull()));
+                    if (!this_shard_owns(dk)) {
+                        continue;
+                    }
+                    it = partitions.emplace(table_schema->ks_name(), mutation(schema(), std::move(dk))).first;
+                }
+                auto ck = clustering_key::from_exploded(*schema(), {
+                        data_value(table_schema->cf_name()).serialize_nonnull(),
+                        data_value(operation).serialize_nonnull(),
+                        data_value(format("{}", r.item.key.key().with_schema(*table_schema))).serialize_nonnull()});
+                row& cr = it->second.partition().clustered_row(*schema(), ck).cells();
+                set_cell(cr, "count", int64_t(r.count));
+                set_cell(cr, "error", int64_t(r.error));
+            }
+        };
+        add_rows(reads, "read");
+        add_rows(writes, "write");
+        for (auto& [ks, m] : partitions) {
+            mutation_sink(std::move(m));
+        }
+    }
+};
+
+class stage_latencies_table : public memtable_filling_virtual_table {
+public:
+    explicit stage_latencies_table()
+        : memtable_filling_virtual_table(build_schema()) {
+        _shard_aware = true;
+    }
+
+    static schema_ptr build_schema() {
+        auto id = generate_legacy_id(system_keyspace::NAME, "stage_latencies");
+        return schema_builder(system_keyspace::NAME, "stage_latencies", std::make_optional(id))
+            .with_column("stage", utf8_type, column_kind::partition_key)
+            .with_column("shard", int32_type, column_kind::clustering_key)
+            .with_column("count", long_type)
+            .with_column("mean_us", long_type)
+            .with_column("p50_us", long_type)
+            .with_column("p90_us", long_type)
+            .with_column("p99_us", long_type)
+            .with_column("p999_us", long_type)
+            .with_column("max_us", long_type)
+            .set_comment("Sampled latencies of request stages, per shard.")
+            .with_version(system_keyspace::generate_schema_version(id))
+            .build();
+    }
+
+    future<> execute(std::function<void(mutation)> mutation_sink) override {
+        for (size_t i = 0; i < tracing::stage_count; ++i) {
+            const auto stage = tracing::stage(i);
+            auto dk = dht::decorate_key(*_s, partition_key::from_single_value(*schema(), data_value(sstring(tracing::stage_name(stage))).serialize_nonnull()));
+            if (!this_shard_owns(dk)) {
+                continue;
+            }
+            mutation m(schema(), std::move(dk));
+            for (unsigned shard = 0; shard < smp::count; ++shard) {
+                const auto histogram = co_await smp::submit_to(shard, [stage] {
+                    return tracing::local_stage_latencies().histogram(stage);
+                });
+                auto ck = clustering_key::from_single_value(*schema(), data_value(int32_t(shard)).serialize_nonnull());
+                row& cr = m.partition().clustered_row(*schema(), ck).cells();
+                set_cell(cr, "count", int64_t(histogram.count()));
+                set_cell(cr, "mean_us", int64_t(histogram.mean()));
+                set_cell(cr, "p50_us", int64_t(histogram.quantile(0.5)));
+                set_cell(cr, "p90_us", int64_t(histogram.quantile(0.9)));
+                set_cell(cr, "p99_us", int64_t(histogram.quantile(0.99)));
+                set_cell(cr, "p999_us", int64_t(histogram.quantile(0.999)));
+                set_cell(cr, "max_us", int64_t(std::min<uint64_t>(histogram.max(), std::numeric_limits<int64_t>::max())));
+            }
+            mutation_sink(std::move(m));
+        }
+    }
+};
+
 class runtime_info_table : public memtable_filling_virtual_table {
 private:
     distributed<replica::database>& _db;
@@ -2666,6 +2793,8 @@ void register_virtual_tables(distributed<replica::database>& dist_db, distribute
     add_table(std::make_unique<protocol_servers_table>(ss));
     add_table(std::make_unique<runtime_info_table>(dist_db, ss));
     add_table(std::make_unique<versions_table>());
+    add_table(std::make_unique<stage_latencies_table>());
+    add_table(std::make_unique<hot_partitions_table>(dist_db));
     add_table(std::make_unique<db_config_table>(cfg));
     add_table(std::make_unique<clients_table>(ss));
 }
@@ -3072,38 +3201,58 @@ future<service::paxos::paxos_state> system_keyspace::load_paxos_state(partition_
     });
 }
 
-static int32_t paxos_ttl_sec(const schema& s) {
+// The paxos state of a partition is written several times during every LWT round, so the
+// mutations are built and applied directly rather than by executing CQL statements.
+// They are equivalent to "UPDATE system.paxos USING TIMESTAMP <ballot> AND TTL <paxos_grace_seconds> ..."
+class paxos_state_mutation_builder {
+    schema_ptr _paxos_schema = system_keyspace::paxos();
+    mutation _m;
+    clustering_key _ck;
+    api::timestamp_type _timestamp;
+    ttl_opt _ttl;
+    gc_clock::time_point _now = gc_clock::now();
+public:
+    paxos_state_mutation_builder(const schema& s, partition_key_view key, const utils::UUID& ballot, ttl_opt ttl)
+        : _m(_paxos_schema, partition_key::from_single_value(*_paxos_schema, to_legacy(*key.get_compound_type(s), key.representation())))
+        , _ck(clustering_key::from_single_value(*_paxos_schema, uuid_type->decompose(s.id())))
+        , _timestamp(utils::UUID_gen::micros_timestamp(ballot))
+        , _ttl(ttl)
+    { }
+    paxos_state_mutation_builder& set(const bytes& column, const data_value& value) {
+        _m.set_cell(_ck, column, value, _timestamp, _ttl);
+        return *this;
+    }
+    paxos_state_mutation_builder& set_null(const bytes& column) {
+        _m.set_cell(_ck, *_paxos_schema->get_column_definition(column), atomic_cell::make_dead(_timestamp, _now));
+        return *this;
+    }
+    future<> apply(db::timeout_clock::time_point timeout) && {
+        return do_with(std::move(_m), [timeout] (const mutation& m) {
+            return qctx->qp().proxy().mutate_locally(m, tracing::trace_state_ptr(), db::commitlog::force_sync::no, timeout);
+        });
+    }
+};
+
+static ttl_opt paxos_ttl(const schema& s) {
     // Keep paxos state around for paxos_grace_seconds. If one of the Paxos participants
     // is down for longer than paxos_grace_seconds it is considered to be dead and must rebootstrap.
     // Otherwise its Paxos table state will be repaired by nodetool repair or Paxos repair.
-    return std::chrono::duration_cast<std::chrono::seconds>(s.paxos_grace_seconds()).count();
+    auto ttl = std::chrono::duration_cast<gc_clock::duration>(s.paxos_grace_seconds());
+    return ttl.count() > 0 ? ttl_opt(ttl) : std::nullopt;
 }
 
 future<> system_keyspace::save_paxos_promise(const schema& s, const partition_key& key, const utils::UUID& ballot, db::timeout_clock::time_point timeout) {
-    static auto cql = format("UPDATE system.{} USING TIMESTAMP ? AND TTL ? SET promise = ? WHERE row_key = ? AND cf_id = ?", PAXOS);
-    return qctx->execute_cql_with_timeout(cql,
-            timeout,
-            utils::UUID_gen::micros_timestamp(ballot),
-            paxos_ttl_sec(s),
-            ballot,
-            to_legacy(*key.get_compound_type(s), key.representation()),
-            s.id()
-        ).discard_result();
+    return paxos_state_mutation_builder(s, key, ballot, paxos_ttl(s))
+            .set("promise", timeuuid_native_type{ballot})
+            .apply(timeout);
 }
 
 future<> system_keyspace::save_paxos_proposal(const schema& s, const service::paxos::proposal& proposal, db::timeout_clock::time_point timeout) {
-    static auto cql = format("UPDATE system.{} USING TIMESTAMP ? AND TTL ? SET promise = ?, proposal_ballot = ?, proposal = ? WHERE row_key = ? AND cf_id = ?", PAXOS);
-    partition_key_view key = proposal.update.key();
-    return qctx->execute_cql_with_timeout(cql,
-            timeout,
-            utils::UUID_gen::micros_timestamp(proposal.ballot),
-            paxos_ttl_sec(s),
-            proposal.ballot,
-            proposal.ballot,
-            ser::serialize_to_buffer<bytes>(proposal.update),
-            to_legacy(*key.get_compound_type(s), key.representation()),
-            s.id()
-        ).discard_result();
+    return paxos_state_mutation_builder(s, proposal.update.key(), proposal.ballot, paxos_ttl(s))
+            .set("promise", timeuuid_native_type{proposal.ballot})
+            .set("proposal_ballot", timeuuid_native_type{proposal.ballot})
+            .set("proposal", ser::serialize_to_buffer<bytes>(proposal.update))
+            .apply(timeout);
 }
 
 future<> system_keyspace::save_paxos_decision(const schema& s, const service::paxos::proposal& decision, db::timeout_clock::time_point timeout) {
@@ -3113,32 +3262,21 @@ future<> system_keyspace::save_paxos_decision(const schema& s, const service::pa
     // Erasing the last proposal is just an optimization and does not affect correctness:
     // sp::begin_and_repair_paxos will exclude an accepted proposal if it is older than the most
     // recent commit.
-    static auto cql = format("UPDATE system.{} USING TIMESTAMP ? AND TTL ? SET proposal_ballot = null, proposal = null,"
-            " most_recent_commit_at = ?, most_recent_commit = ? WHERE row_key = ? AND cf_id = ?", PAXOS);
-    partition_key_view key = decision.update.key();
-    return qctx->execute_cql_with_timeout(cql,
-            timeout,
-            utils::UUID_gen::micros_timestamp(decision.ballot),
-            paxos_ttl_sec(s),
-            decision.ballot,
-            ser::serialize_to_buffer<bytes>(decision.update),
-            to_legacy(*key.get_compound_type(s), key.representation()),
-            s.id()
-        ).discard_result();
+    return paxos_state_mutation_builder(s, decision.update.key(), decision.ballot, paxos_ttl(s))
+            .set_null("proposal_ballot")
+            .set_null("proposal")
+            .set("most_recent_commit_at", timeuuid_native_type{decision.ballot})
+            .set("most_recent_commit", ser::serialize_to_buffer<bytes>(decision.update))
+            .apply(timeout);
 }
 
 future<> system_keyspace::delete_paxos_decision(const schema& s, const partition_key& key, const utils::UUID& ballot, db::timeout_clock::time_point timeout) {
     // This should be called only if a learn stage succeeded on all replicas.
     // In this case we can remove learned paxos value using ballot's timestamp which
     // guarantees that if there is more recent round it will not be affected.
-    static auto cql = format("DELETE most_recent_commit FROM system.{} USING TIMESTAMP ?  WHERE row_key = ? AND cf_id = ?", PAXOS);
-
-    return qctx->execute_cql_with_timeout(cql,
-            timeout,
-            utils::UUID_gen::micros_timestamp(ballot),
-            to_legacy(*key.get_compound_type(s), key.representation()),
-            s.id()
-        ).discard_result();
+    return paxos_state_mutation_builder(s, key, ballot, std::nullopt)
+            .set_null("most_recent_commit")
+            .apply(timeout);
 }
 
 future<> system_keyspace::enable_features_on_startup(sharded<gms::feature_service>& feat) {
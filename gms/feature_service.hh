@@ -112,6 +112,8 @@ class feature_service final {
     gms::feature schema_commitlog { *this, "SCHEMA_COMMITLOG"sv };
     gms::feature uda_native_parallelized_aggregation { *this, "UDA_NATIVE_PARALLELIZED_AGGREGATION"sv };
     gms::feature aggregate_storage_options { *this, "AGGREGATE_STORAGE_OPTIONS"sv };
+    gms::feature hint_mutation_batch { *this, "HINT_MUTATION_BATCH"sv };
+    gms::feature cache_compression { *this, "CACHE_COMPRESSION"sv };
 
 public:
 
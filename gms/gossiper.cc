@@ -30,6 +30,7 @@
 #include <seastar/util/defer.hh>
 #include <seastar/core/coroutine.hh>
 #include <seastar/coroutine/parallel_for_each.hh>
+#include <seastar/coroutine/as_future.hh>
 #include <chrono>
 #include "db/config.hh"
 #include <boost/range/algorithm/set_algorithm.hpp>
@@ -1091,7 +1092,7 @@ std::set<inet_address> gossiper::get_unreachable_members() {
     return ret;
 }
 
-int gossiper::get_max_endpoint_state_version(endpoint_state state) const noexcept {
+int gossiper::get_max_endpoint_state_version(const endpoint_state& state) const noexcept {
     int max_version = state.get_heart_beat_state().get_heart_beat_version();
     for (auto& entry : state.get_application_state_map()) {
         auto& value = entry.second;
@@ -1159,16 +1160,6 @@ future<> gossiper::replicate(inet_address ep, const endpoint_state& es) {
     });
 }
 
-future<> gossiper::replicate(inet_address ep, const std::map<application_state, versioned_value>& src, const utils::chunked_vector<application_state>& changed) {
-    return container().invoke_on_all([ep, &src, &changed, orig = this_shard_id(), self = shared_from_this()] (gossiper& g) {
-        if (this_shard_id() != orig) {
-            for (auto&& key : changed) {
-                g._endpoint_state_map[ep].add_application_state(key, src.at(key));
-            }
-        }
-    });
-}
-
 future<> gossiper::replicate(inet_address ep, application_state key, const versioned_value& value) {
     return container().invoke_on_all([ep, key, &value, orig = this_shard_id(), self = shared_from_this()] (gossiper& g) {
         if (this_shard_id() != orig) {
@@ -1177,6 +1168,45 @@ future<> gossiper::replicate(inet_address ep, application_state key, const versi
     });
 }
 
+future<> gossiper::replicate_batched(inet_address ep, const std::map<application_state, versioned_value>& src, const utils::chunked_vector<application_state>& changed) {
+    if (changed.empty()) {
+        co_return;
+    }
+    if (!_pending_replication_batch) {
+        _pending_replication_batch = make_lw_shared<replication_batch>();
+    }
+    auto batch = _pending_replication_batch;
+    for (auto&& key : changed) {
+        batch->states.emplace_back(ep, key, src.at(key));
+    }
+    auto replicated = batch->replicated.get_shared_future();
+    if (!_replicating_batches) {
+        // No batch is in flight, so this caller replicates the pending ones.
+        co_await replicate_pending_batches();
+    }
+    co_await std::move(replicated);
+}
+
+future<> gossiper::replicate_pending_batches() {
+    _replicating_batches = true;
+    while (auto batch = std::exchange(_pending_replication_batch, nullptr)) {
+        const auto& states = batch->states;
+        auto f = co_await coroutine::as_future(container().invoke_on_all([&states, orig = this_shard_id(), self = shared_from_this()] (gossiper& g) {
+            if (this_shard_id() != orig) {
+                for (auto&& [ep, key, value] : states) {
+                    g._endpoint_state_map[ep].add_application_state(key, value);
+                }
+            }
+        }));
+        if (f.failed()) {
+            batch->replicated.set_exception(f.get_exception());
+        } else {
+            batch->replicated.set_value();
+        }
+    }
+    _replicating_batches = false;
+}
+
 future<> gossiper::advertise_removing(inet_address endpoint, utils::UUID host_id, utils::UUID local_host_id) {
     auto& state = get_endpoint_state(endpoint);
     // remember this node's generation
@@ -1680,13 +1710,13 @@ future<> gossiper::apply_new_states(inet_address addr, endpoint_state& local_sta
 
     std::exception_ptr ep;
     try {
+        auto remote_gen = remote_state.get_heart_beat_state().get_generation();
+        auto local_gen = local_state.get_heart_beat_state().get_generation();
         // we need to make two loops here, one to apply, then another to notify,
         // this way all states in an update are present and current when the notifications are received
         for (const auto& remote_entry : remote_map) {
             const auto& remote_key = remote_entry.first;
             const auto& remote_value = remote_entry.second;
-            auto remote_gen = remote_state.get_heart_beat_state().get_generation();
-            auto local_gen = local_state.get_heart_beat_state().get_generation();
             if(remote_gen != local_gen) {
                 auto err = format("Remote generation {:d} != local generation {:d}", remote_gen, local_gen);
                 logger.warn("{}", err);
@@ -1707,7 +1737,9 @@ future<> gossiper::apply_new_states(inet_address addr, endpoint_state& local_sta
     // Exceptions during replication will cause abort because node's state
     // would be inconsistent across shards. Changes listeners depend on state
     // being replicated to all shards.
-    co_await replicate(addr, remote_map, changed);
+    // Most gossip rounds only bump heartbeats, which are not replicated,
+    // so replicate_batched() is a no-op unless an application state changed.
+    co_await replicate_batched(addr, remote_map, changed);
 
     // Exceptions thrown from listeners will result in abort because that could leave the node in a bad
     // state indefinitely. Unless the value changes again, we wouldn't retry notifications.
@@ -36,6 +36,7 @@
 #include <chrono>
 #include <set>
 #include <seastar/core/condition-variable.hh>
+#include <seastar/core/shared_future.hh>
 #include <seastar/core/metrics_registration.hh>
 #include <seastar/core/abort_source.hh>
 #include <seastar/core/scheduling.hh>
@@ -233,12 +234,23 @@ class gossiper : public seastar::async_sharded_service<gossiper>, public seastar
     // Replicates given endpoint_state to all other shards.
     // The state state doesn't have to be kept alive around until completes.
     future<> replicate(inet_address, const endpoint_state&);
-    // Replicates "states" from "src" to all other shards.
-    // "src" and "states" must be kept alive until completes and must not change.
-    future<> replicate(inet_address, const std::map<application_state, versioned_value>& src, const utils::chunked_vector<application_state>& states);
     // Replicates given value to all other shards.
     // The value must be kept alive until completes and not change.
     future<> replicate(inet_address, application_state key, const versioned_value& value);
+    // Replicates "states" from "src" to all other shards, together with the
+    // states passed by concurrent callers, so that applying gossip about many
+    // endpoints costs one cross-shard round trip per batch, not per endpoint.
+    // The states are copied, so "src" doesn't have to be kept alive.
+    future<> replicate_batched(inet_address, const std::map<application_state, versioned_value>& src, const utils::chunked_vector<application_state>& states);
+    future<> replicate_pending_batches();
+
+    struct replication_batch {
+        std::vector<std::tuple<inet_address, application_state, versioned_value>> states;
+        shared_promise<> replicated;
+    };
+    // Collects states for replicate_batched() while the previous batch is being replicated.
+    lw_shared_ptr<replication_batch> _pending_replication_batch;
+    bool _replicating_batches = false;
 public:
     explicit gossiper(abort_source& as, feature_service& features, const locator::shared_token_metadata& stm, netw::messaging_service& ms, sharded<db::system_keyspace>& sys_ks, const db::config& cfg, gossip_config gcfg);
 
@@ -285,7 +297,7 @@ class gossiper : public seastar::async_sharded_service<gossiper>, public seastar
      * @param ep_state
      * @return
      */
-    int get_max_endpoint_state_version(endpoint_state state) const noexcept;
+    int get_max_endpoint_state_version(const endpoint_state& state) const noexcept;
 
 
 private:
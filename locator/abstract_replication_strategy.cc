@@ -301,26 +301,130 @@ abstract_replication_strategy::get_pending_address_ranges(const token_metadata_p
     co_return ret;
 }
 
-future<mutable_effective_replication_map_ptr> calculate_effective_replication_map(abstract_replication_strategy::ptr_type rs, token_metadata_ptr tmptr) {
+namespace {
+
+// The changes between the rings of two token_metadata, as seen by ring walks
+// over the older one.
+class ring_changes {
+    const std::vector<token>& _tokens;
+    // The owner of each token of the older ring.
+    std::vector<inet_address> _owners;
+    // Whether each token of the older ring was removed or moved to another owner.
+    std::vector<bool> _token_changed;
+    // Whether tokens were added right before each token of the older ring.
+    std::vector<bool> _gap_changed;
+public:
+    explicit ring_changes(const token_metadata& old_tm)
+        : _tokens(old_tm.sorted_tokens())
+        , _token_changed(_tokens.size())
+        , _gap_changed(_tokens.size())
+    {}
+
+    future<> compute(const token_metadata& old_tm, const token_metadata& new_tm) {
+        const auto& new_tokens = new_tm.sorted_tokens();
+        _owners.reserve(_tokens.size());
+        size_t i = 0;
+        size_t j = 0;
+        while (i < _tokens.size()) {
+            _owners.push_back(*old_tm.get_endpoint(_tokens[i]));
+            if (j < new_tokens.size() && new_tokens[j] < _tokens[i]) {
+                _gap_changed[i] = true;
+                do {
+                    ++j;
+                } while (j < new_tokens.size() && new_tokens[j] < _tokens[i]);
+            }
+            if (j < new_tokens.size() && new_tokens[j] == _tokens[i]) {
+                _token_changed[i] = *new_tm.get_endpoint(new_tokens[j]) != _owners[i];
+                ++j;
+            } else {
+                _token_changed[i] = true;
+            }
+            ++i;
+            co_await coroutine::maybe_yield();
+        }
+        // Tokens past the end of the older ring wrap around to its beginning.
+        if (j < new_tokens.size() && !_gap_changed.empty()) {
+            _gap_changed[0] = true;
+        }
+    }
+
+    // Whether a ring walk over the newer ring, starting at the token,
+    // would see the same tokens and owners as the walk over the older ring
+    // that produced `replicas`, so produces them too.
+    bool walk_unchanged(const token& t, const inet_address_vector_replica_set& replicas) const {
+        auto it = std::lower_bound(_tokens.begin(), _tokens.end(), t);
+        if (it == _tokens.end() || *it != t || replicas.empty()) {
+            return false;
+        }
+        const auto& last = replicas.back();
+        auto i = size_t(std::distance(_tokens.begin(), it));
+        for (size_t n = 0; n < _tokens.size(); ++n) {
+            if (_token_changed[i] || (n && _gap_changed[i])) {
+                return false;
+            }
+            if (_owners[i] == last) {
+                return true;
+            }
+            i = i + 1 == _tokens.size() ? 0 : i + 1;
+        }
+        return false;
+    }
+};
+
+}
+
+future<mutable_effective_replication_map_ptr> calculate_effective_replication_map(abstract_replication_strategy::ptr_type rs, token_metadata_ptr tmptr,
+        effective_replication_map_ptr previous) {
     replication_map replication_map;
+    auto rf = rs->get_replication_factor(*tmptr);
 
+    std::optional<ring_changes> changes;
+    if (previous && rs->natural_endpoints_follow_ring_walk() && previous->get_replication_factor() == rf) {
+        const auto& old_tm = *previous->get_token_metadata_ptr();
+        const auto& old_topology = old_tm.get_topology();
+        const auto& new_topology = tmptr->get_topology();
+        if (old_topology.get_datacenter_endpoints() == new_topology.get_datacenter_endpoints()
+                && old_topology.get_datacenter_racks() == new_topology.get_datacenter_racks()) {
+            changes.emplace(old_tm);
+            co_await changes->compute(old_tm, *tmptr);
+        }
+    }
+
+    size_t reused = 0;
+    replication_map.reserve(tmptr->sorted_tokens().size());
     for (const auto &t : tmptr->sorted_tokens()) {
+        if (changes) {
+            const auto& old_map = previous->get_replication_map();
+            auto it = old_map.find(t);
+            // A walk which didn't collect all the replicas went around the whole ring.
+            if (it != old_map.end() && it->second.size() == rf && changes->walk_unchanged(t, it->second)) {
+                replication_map.emplace(t, it->second);
+                ++reused;
+                co_await coroutine::maybe_yield();
+                continue;
+            }
+        }
         replication_map.emplace(t, co_await rs->calculate_natural_endpoints(t, *tmptr));
     }
+    if (changes) {
+        rslogger.debug("calculate_effective_replication_map: reused the replicas of {} out of {} tokens", reused, replication_map.size());
+    }
 
-    auto rf = rs->get_replication_factor(*tmptr);
     co_return make_effective_replication_map(std::move(rs), std::move(tmptr), std::move(replication_map), rf);
 }
 
-future<replication_map> effective_replication_map::clone_endpoints_gently() const {
-    replication_map cloned_endpoints;
-
-    for (auto& i : _replication_map) {
-        cloned_endpoints.emplace(i.first, i.second);
-        co_await coroutine::maybe_yield();
+// Drops a reference to a shared replication map, clearing the map gently,
+// on the shard which owns it, if it was the last reference.
+static future<> release_replication_map_gently(replication_map_ptr p) {
+    if (!p) {
+        co_return;
     }
-
-    co_return cloned_endpoints;
+    auto owner = p.get_owner_shard();
+    co_await smp::submit_to(owner, [p = std::move(p)] () mutable {
+        return do_with(p.release(), [] (lw_shared_ptr<replication_map>& m) {
+            return utils::clear_gently(m);
+        });
+    });
 }
 
 inet_address_vector_replica_set effective_replication_map::get_natural_endpoints(const token& search_token) const {
@@ -328,7 +432,7 @@ inet_address_vector_replica_set effective_replication_map::get_natural_endpoints
 }
 
 future<> effective_replication_map::clear_gently() noexcept {
-    co_await utils::clear_gently(_replication_map);
+    co_await release_replication_map_gently(std::move(_replication_map));
     co_await utils::clear_gently(_tmptr);
 }
 
@@ -337,11 +441,10 @@ effective_replication_map::~effective_replication_map() {
         _factory->erase_effective_replication_map(this);
         try {
             struct background_clear_holder {
-                locator::replication_map replication_map;
                 locator::token_metadata_ptr tmptr;
             };
-            auto holder = make_lw_shared<background_clear_holder>({std::move(_replication_map), std::move(_tmptr)});
-            auto fut = when_all(utils::clear_gently(holder->replication_map), utils::clear_gently(holder->tmptr)).discard_result().then([holder] {});
+            auto holder = make_lw_shared<background_clear_holder>({std::move(_tmptr)});
+            auto fut = when_all(release_replication_map_gently(std::move(_replication_map)), utils::clear_gently(holder->tmptr)).discard_result().then([holder] {});
             _factory->submit_background_work(std::move(fut));
         } catch (...) {
             // ignore
@@ -373,10 +476,11 @@ future<effective_replication_map_ptr> effective_replication_map_factory::create_
     mutable_effective_replication_map_ptr new_erm;
     if (ref_erm) {
         auto rf = ref_erm->get_replication_factor();
-        auto local_replication_map = co_await ref_erm->clone_endpoints_gently();
-        new_erm = make_effective_replication_map(std::move(rs), std::move(tmptr), std::move(local_replication_map), rf);
+        auto shared_replication_map = co_await ref_erm->share_replication_map();
+        new_erm = make_effective_replication_map(std::move(rs), std::move(tmptr), std::move(shared_replication_map), rf);
     } else {
-        new_erm = co_await calculate_effective_replication_map(std::move(rs), std::move(tmptr));
+        auto previous = find_previous_effective_replication_map(key);
+        new_erm = co_await calculate_effective_replication_map(std::move(rs), std::move(tmptr), std::move(previous));
     }
     co_return insert_effective_replication_map(std::move(new_erm), std::move(key));
 }
@@ -389,6 +493,20 @@ effective_replication_map_ptr effective_replication_map_factory::find_effective_
     return {};
 }
 
+effective_replication_map_ptr effective_replication_map_factory::find_previous_effective_replication_map(const effective_replication_map::factory_key& key) const {
+    effective_replication_map* previous = nullptr;
+    for (const auto& [k, erm] : _effective_replication_maps) {
+        if (k.rs_type == key.rs_type && k.rs_config_options == key.rs_config_options && k.ring_version < key.ring_version
+                && (!previous || k.ring_version > previous->get_factory_key().ring_version)) {
+            previous = erm;
+        }
+    }
+    if (!previous) {
+        return {};
+    }
+    return previous->shared_from_this();
+}
+
 effective_replication_map_ptr effective_replication_map_factory::insert_effective_replication_map(mutable_effective_replication_map_ptr erm, effective_replication_map::factory_key key) {
     auto [it, inserted] = _effective_replication_maps.insert({key, erm.get()});
     if (inserted) {
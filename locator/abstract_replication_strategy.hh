@@ -44,6 +44,11 @@ using replication_strategy_config_options = std::map<sstring, sstring>;
 
 using replication_map = std::unordered_map<token, inet_address_vector_replica_set>;
 
+// A replication_map is computed once, on shard 0, and shared read-only by the
+// effective_replication_maps of all shards. It is freed on shard 0 when the
+// last of them releases it.
+using replication_map_ptr = foreign_ptr<lw_shared_ptr<replication_map>>;
+
 class effective_replication_map;
 class effective_replication_map_factory;
 
@@ -104,6 +109,16 @@ class abstract_replication_strategy {
     // returns the node itself as the natural_endpoints and the node will not
     // appear in the pending_endpoints.
     virtual bool allow_remove_node_being_replaced_from_natural_endpoints() const = 0;
+    // Whether calculate_natural_endpoints() walks the ring starting at the token
+    // and returns the endpoints it accepts, in the order it accepts them,
+    // stopping right after accepting the last one, and never accepting an
+    // endpoint it has already rejected during the same walk.
+    // The replicas of a token then depend only on the topology and on the
+    // tokens up to the first one owned by the last replica, which lets
+    // calculate_effective_replication_map() reuse them across ring changes.
+    virtual bool natural_endpoints_follow_ring_walk() const noexcept {
+        return false;
+    }
     replication_strategy_type get_type() const noexcept { return _my_type; }
     const replication_strategy_config_options get_config_options() const noexcept { return _config_options; }
 
@@ -151,7 +166,7 @@ class effective_replication_map : public enable_lw_shared_from_this<effective_re
 private:
     abstract_replication_strategy::ptr_type _rs;
     token_metadata_ptr _tmptr;
-    replication_map _replication_map;
+    replication_map_ptr _replication_map;
     size_t _replication_factor;
     std::optional<factory_key> _factory_key = std::nullopt;
     effective_replication_map_factory* _factory = nullptr;
@@ -159,7 +174,13 @@ class effective_replication_map : public enable_lw_shared_from_this<effective_re
     friend class abstract_replication_strategy;
     friend class effective_replication_map_factory;
 public:
-    explicit effective_replication_map(abstract_replication_strategy::ptr_type rs, token_metadata_ptr tmptr, replication_map replication_map, size_t replication_factor) noexcept
+    explicit effective_replication_map(abstract_replication_strategy::ptr_type rs, token_metadata_ptr tmptr, replication_map replication_map, size_t replication_factor)
+        : _rs(std::move(rs))
+        , _tmptr(std::move(tmptr))
+        , _replication_map(make_foreign(make_lw_shared<locator::replication_map>(std::move(replication_map))))
+        , _replication_factor(replication_factor)
+    { }
+    explicit effective_replication_map(abstract_replication_strategy::ptr_type rs, token_metadata_ptr tmptr, replication_map_ptr replication_map, size_t replication_factor) noexcept
         : _rs(std::move(rs))
         , _tmptr(std::move(tmptr))
         , _replication_map(std::move(replication_map))
@@ -174,7 +195,7 @@ class effective_replication_map : public enable_lw_shared_from_this<effective_re
     }
 
     const replication_map& get_replication_map() const noexcept {
-        return _replication_map;
+        return *_replication_map;
     }
 
     const size_t get_replication_factor() const noexcept {
@@ -183,7 +204,11 @@ class effective_replication_map : public enable_lw_shared_from_this<effective_re
 
     future<> clear_gently() noexcept;
 
-    future<replication_map> clone_endpoints_gently() const;
+    // Returns another reference to the replication map, for an
+    // effective_replication_map of the same ring on another shard.
+    future<replication_map_ptr> share_replication_map() const {
+        return _replication_map.copy();
+    }
 
     inet_address_vector_replica_set get_natural_endpoints(const token& search_token) const;
     inet_address_vector_replica_set get_natural_endpoints_without_node_being_replaced(const token& search_token) const;
@@ -247,8 +272,19 @@ inline mutable_effective_replication_map_ptr make_effective_replication_map(abst
     return make_lw_shared<effective_replication_map>(std::move(rs), std::move(tmptr), std::move(replication_map), replication_factor);
 }
 
+inline mutable_effective_replication_map_ptr make_effective_replication_map(abstract_replication_strategy::ptr_type rs, token_metadata_ptr tmptr, replication_map_ptr replication_map, size_t replication_factor) {
+    return make_lw_shared<effective_replication_map>(std::move(rs), std::move(tmptr), std::move(replication_map), replication_factor);
+}
+
 // Apply the replication strategy over the current configuration and the given token_metadata.
-future<mutable_effective_replication_map_ptr> calculate_effective_replication_map(abstract_replication_strategy::ptr_type rs, token_metadata_ptr tmptr);
+//
+// If `previous` is the effective_replication_map of the same strategy and
+// options over an earlier ring, and the strategy's natural endpoints follow a
+// ring walk, the replicas of tokens whose walk doesn't reach any token that
+// was added, removed or moved to another owner are copied from it rather
+// than recomputed.
+future<mutable_effective_replication_map_ptr> calculate_effective_replication_map(abstract_replication_strategy::ptr_type rs, token_metadata_ptr tmptr,
+        effective_replication_map_ptr previous = {});
 
 } // namespace locator
 
@@ -318,8 +354,9 @@ class effective_replication_map_factory : public peering_sharded_service<effecti
 public:
     // looks up the effective_replication_map on the local shard.
     // If not found, tries to look one up for reference on shard 0
-    // so its replication map can be cloned.  Otherwise, calculates the
-    // effective_replication_map for the local shard.
+    // so its replication map can be shared.  Otherwise, calculates the
+    // effective_replication_map for the local shard, incrementally from
+    // the one of the previous ring if there is one.
     //
     // Therefore create should be called first on shard 0, then on all other shards.
     future<effective_replication_map_ptr> create_effective_replication_map(abstract_replication_strategy::ptr_type rs, token_metadata_ptr tmptr);
@@ -332,6 +369,9 @@ class effective_replication_map_factory : public peering_sharded_service<effecti
 
 private:
     effective_replication_map_ptr find_effective_replication_map(const effective_replication_map::factory_key& key) const;
+    // Finds the map of the same strategy and options over the most recent
+    // ring older than the key's, to seed calculate_effective_replication_map().
+    effective_replication_map_ptr find_previous_effective_replication_map(const effective_replication_map::factory_key& key) const;
     effective_replication_map_ptr insert_effective_replication_map(mutable_effective_replication_map_ptr erm, effective_replication_map::factory_key key);
 
     bool erase_effective_replication_map(effective_replication_map* erm);
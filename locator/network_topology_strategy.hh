@@ -40,6 +40,10 @@ class network_topology_strategy : public abstract_replication_strategy {
         return true;
     }
 
+    virtual bool natural_endpoints_follow_ring_walk() const noexcept override {
+        return true;
+    }
+
 protected:
     /**
      * calculate endpoints in one pass through the tokens by tracking our
@@ -26,6 +26,10 @@ class simple_strategy : public abstract_replication_strategy {
         return true;
     }
 
+    virtual bool natural_endpoints_follow_ring_walk() const noexcept override {
+        return true;
+    }
+
     virtual future<inet_address_vector_replica_set> calculate_natural_endpoints(const token& search_token, const token_metadata& tm) const override;
 private:
     size_t _replication_factor = 1;
@@ -493,6 +493,7 @@ static constexpr unsigned do_get_rpc_client_idx(messaging_verb verb) {
     case messaging_verb::REPAIR_FLUSH_HINTS_BATCHLOG:
     case messaging_verb::NODE_OPS_CMD:
     case messaging_verb::HINT_MUTATION:
+    case messaging_verb::HINT_MUTATION_BATCH:
         return 1;
     case messaging_verb::CLIENT_ID:
     case messaging_verb::MUTATION:
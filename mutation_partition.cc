@@ -944,6 +944,37 @@ void row::clear_hash() const {
     });
 }
 
+void row::compress_cells(const schema& s, column_kind kind) {
+    for_each_cell([&s, kind] (column_id id, atomic_cell_or_collection& cell) {
+        auto& def = s.column_at(kind, id);
+        if (!def.is_atomic() || def.is_counter()) {
+            return;
+        }
+        if (auto compressed = atomic_cell::make_compressed(cell.as_atomic_cell(def))) {
+            cell = atomic_cell_or_collection(std::move(*compressed));
+        }
+    });
+}
+
+void row::decompress_cells(const schema& s, column_kind kind) {
+    for_each_cell([&s, kind] (column_id id, atomic_cell_or_collection& cell) {
+        auto& def = s.column_at(kind, id);
+        if (def.is_atomic() && cell.as_atomic_cell(def).is_compressed()) {
+            cell = atomic_cell_or_collection(atomic_cell::make_decompressed(cell.as_atomic_cell(def)));
+        }
+    });
+}
+
+bool row::has_compressed_cells(const schema& s, column_kind kind) const {
+    bool found = false;
+    for_each_cell_until([&] (column_id id, const atomic_cell_or_collection& cell) {
+        auto& def = s.column_at(kind, id);
+        found = def.is_atomic() && cell.as_atomic_cell(def).is_compressed();
+        return stop_iteration(found);
+    });
+    return found;
+}
+
 template<typename RowWriter>
 static void get_compacted_row_slice(const schema& s,
     const query::partition_slice& slice,
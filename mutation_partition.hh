@@ -215,6 +215,13 @@ class row {
     void prepare_hash(const schema& s, column_kind kind) const;
     void clear_hash() const;
 
+    // Replaces cells which are worth compressing with their compressed form,
+    // see atomic_cell::make_compressed(). Cell hashes stay valid.
+    void compress_cells(const schema& s, column_kind kind);
+    // Replaces compressed cells with their decompressed form.
+    void decompress_cells(const schema& s, column_kind kind);
+    bool has_compressed_cells(const schema& s, column_kind kind) const;
+
     bool is_live(const schema&, column_kind kind, tombstone tomb = tombstone(), gc_clock::time_point now = gc_clock::time_point::min()) const;
 
     class printer {
@@ -479,34 +479,53 @@ class partition_snapshot_row_cursor final {
         for (size_t i = 1; i < _current_row.size(); ++i) {
             cr.apply(_schema, _current_row[i].it->row());
         }
+        // Cells may be kept compressed in cache, see caching_options::compressed().
+        // Only rows which are read get decompressed.
+        cr.cells().decompress_cells(_schema, column_kind::regular_column);
         return cr;
     }
 
     // Can be called only when cursor is valid and pointing at a row.
+    // Unlike row() and consume_row(), this exposes the row as it is stored, its cells
+    // may be compressed (see caching_options::compressed()). It may only be used for
+    // in-place maintenance of the row, like computing cell hashes, and must not be
+    // used to copy cells out of the snapshot.
     deletable_row& latest_row() const noexcept {
         return _current_row[0].it->row();
     }
 
     // Can be called only when cursor is valid and pointing at a row.
     // Monotonic exception guarantees.
+    // Like row(), the consumer never sees compressed cells.
     template <typename Consumer>
     requires std::is_invocable_v<Consumer, deletable_row>
     void consume_row(Consumer&& consumer) {
         for (position_in_version& v : _current_row) {
             if (v.unique_owner) {
+                v.it->row().cells().decompress_cells(_schema, column_kind::regular_column);
                 consumer(std::move(v.it->row()));
             } else {
-                consumer(deletable_row(_schema, v.it->row()));
+                deletable_row r(_schema, v.it->row());
+                r.cells().decompress_cells(_schema, column_kind::regular_column);
+                consumer(std::move(r));
             }
         }
     }
 
     // Can be called only when cursor is valid and pointing at a row.
+    // Like row(), the consumer never sees compressed cells.
     template <typename Consumer>
     requires std::is_invocable_v<Consumer, const deletable_row&>
     void consume_row(Consumer&& consumer) const {
         for (const position_in_version& v : _current_row) {
-            consumer(v.it->row());
+            const deletable_row& r = v.it->row();
+            if (r.cells().has_compressed_cells(_schema, column_kind::regular_column)) {
+                deletable_row decompressed(_schema, r);
+                decompressed.cells().decompress_cells(_schema, column_kind::regular_column);
+                consumer(std::as_const(decompressed));
+            } else {
+                consumer(r);
+            }
         }
     }
 
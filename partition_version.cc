@@ -111,7 +111,7 @@ inline Result squashed(const partition_version_ref& v, Map&& map, Reduce&& reduc
 }
 
 ::static_row partition_snapshot::static_row(bool digest_requested) const {
-    return ::static_row(::squashed<row>(version(),
+    auto sr = ::static_row(::squashed<row>(version(),
                          [&] (const mutation_partition& mp) -> const row& {
                             if (digest_requested) {
                                 mp.static_row().prepare_hash(*_schema, column_kind::static_column);
@@ -120,6 +120,9 @@ ::static_row partition_snapshot::static_row(bool digest_requested) const {
                          },
                          [this] (const row& r) { return row(*_schema, column_kind::static_column, r); },
                          [this] (row& a, const row& b) { a.apply(*_schema, column_kind::static_column, b); }));
+    // Cells may be kept compressed in cache, see caching_options::compressed().
+    sr.cells().decompress_cells(*_schema, column_kind::static_column);
+    return sr;
 }
 
 bool partition_snapshot::static_row_continuous() const {
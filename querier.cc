@@ -241,7 +241,13 @@ void querier_cache::insert_querier(
 
     auto& sem = q.permit().semaphore();
 
-    auto irh = sem.register_inactive_read(querier_utils::get_reader(q));
+    q.permit().on_page_saved();
+    const bool established_scan = q.permit().saved_pages() >= established_scan_pages;
+    if (established_scan) {
+        ttl *= established_scan_ttl_factor;
+    }
+
+    auto irh = sem.register_inactive_read(querier_utils::get_reader(q), reader_concurrency_semaphore::evict_first(!established_scan));
     if (!irh) {
         ++stats.resource_based_evictions;
         return;
@@ -270,6 +270,12 @@ class shard_mutation_querier : public querier_base {
 class querier_cache {
 public:
     static const std::chrono::seconds default_entry_ttl;
+    /// Queriers whose permit saved at least this many pages belong to scans
+    /// which are likely to go on. They stay in the cache
+    /// established_scan_ttl_factor times longer than the others, and the
+    /// others are evicted first when the semaphore runs short of resources.
+    static constexpr uint64_t established_scan_pages = 4;
+    static constexpr unsigned established_scan_ttl_factor = 3;
 
     struct stats {
         // The number of inserts into the cache.
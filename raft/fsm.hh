@@ -56,6 +56,9 @@ struct fsm_config {
     size_t max_log_size;
     // If set to true will enable prevoting stage during election
     bool enable_prevoting;
+    // Max number of un-acked append requests sent to a follower
+    // which keeps up with the log
+    size_t max_append_requests_in_flight = 10;
 };
 
 class fsm;
@@ -274,6 +274,9 @@ server_impl::server_impl(server_id uuid, std::unique_ptr<rpc> rpc,
     if (_config.snapshot_threshold > _config.max_log_size) {
         throw config_error("snapshot_threshold has to be smaller than max_log_size");
     }
+    if (_config.max_append_requests_in_flight == 0) {
+        throw config_error("max_append_requests_in_flight has to be positive");
+    }
 }
 
 future<> server_impl::start() {
@@ -291,7 +294,8 @@ future<> server_impl::start() {
                                  fsm_config {
                                      .append_request_threshold = _config.append_request_threshold,
                                      .max_log_size = _config.max_log_size,
-                                     .enable_prevoting = _config.enable_prevoting
+                                     .enable_prevoting = _config.enable_prevoting,
+                                     .max_append_requests_in_flight = _config.max_append_requests_in_flight
                                  });
 
     _applied_idx = index_t{0};
@@ -18,6 +18,7 @@
 #include "utils/exceptions.hh"
 #include "schema.hh"
 #include "utils/human_readable.hh"
+#include "tracing/stage_latencies.hh"
 
 logger rcslog("reader_concurrency_semaphore");
 
@@ -82,6 +83,9 @@ class reader_permit::impl
     bool _marked_as_blocked = false;
     db::timeout_clock::time_point _timeout;
     query::max_result_size _max_result_size{query::result_memory_limiter::unlimited_result_size};
+    uint64_t _saved_pages = 0;
+    // Set when the time this permit spends in the wait queue is sampled.
+    std::optional<tracing::stage_latencies::clock::time_point> _wait_start;
 
 private:
     void on_permit_used() {
@@ -190,6 +194,7 @@ class reader_permit::impl
 
     void on_waiting() {
         on_permit_inactive(reader_permit::state::waiting);
+        _wait_start = tracing::local_stage_latencies().maybe_start(tracing::stage::replica_queue_wait);
     }
 
     void on_admission() {
@@ -197,6 +202,7 @@ class reader_permit::impl
         on_permit_active();
         consume(_base_resources);
         _base_resources_consumed = true;
+        tracing::local_stage_latencies().finish(tracing::stage::replica_queue_wait, std::exchange(_wait_start, std::nullopt));
     }
 
     void on_register_as_inactive() {
@@ -326,6 +332,14 @@ class reader_permit::impl
     void set_max_result_size(query::max_result_size s) {
         _max_result_size = std::move(s);
     }
+
+    uint64_t saved_pages() const noexcept {
+        return _saved_pages;
+    }
+
+    void on_page_saved() noexcept {
+        ++_saved_pages;
+    }
 };
 
 static_assert(std::is_nothrow_copy_constructible_v<reader_permit>);
@@ -434,6 +448,14 @@ void reader_permit::set_max_result_size(query::max_result_size s) {
     _impl->set_max_result_size(std::move(s));
 }
 
+uint64_t reader_permit::saved_pages() const noexcept {
+    return _impl->saved_pages();
+}
+
+void reader_permit::on_page_saved() noexcept {
+    _impl->on_page_saved();
+}
+
 std::ostream& operator<<(std::ostream& os, reader_permit::state s) {
     switch (s) {
         case reader_permit::state::waiting:
@@ -637,7 +659,7 @@ void reader_concurrency_semaphore::signal(const resources& r) noexcept {
 reader_concurrency_semaphore::reader_concurrency_semaphore(int count, ssize_t memory, sstring name, size_t max_queue_length)
     : _initial_resources(count, memory)
     , _resources(count, memory)
-    , _wait_list(expiry_handler(*this))
+    , _wait_list(*this)
     , _ready_list(max_queue_length)
     , _name(std::move(name))
     , _max_queue_length(max_queue_length)
@@ -659,15 +681,16 @@ reader_concurrency_semaphore::~reader_concurrency_semaphore() {
         on_internal_error_noexcept(rcslog, format("~reader_concurrency_semaphore(): semaphore {} not stopped before destruction", _name));
         // With the below conditions, we can get away with the semaphore being
         // unstopped. In this case don't force an abort.
-        assert(_inactive_reads.empty() && !_close_readers_gate.get_count() && !_permit_gate.get_count() && !_execution_loop_future);
+        assert(!has_inactive_reads() && !_close_readers_gate.get_count() && !_permit_gate.get_count() && !_execution_loop_future);
         broken();
     }
 }
 
-reader_concurrency_semaphore::inactive_read_handle reader_concurrency_semaphore::register_inactive_read(flat_mutation_reader_v2 reader) noexcept {
+reader_concurrency_semaphore::inactive_read_handle reader_concurrency_semaphore::register_inactive_read(flat_mutation_reader_v2 reader,
+        evict_first ef) noexcept {
     auto& permit_impl = *reader.permit()._impl;
     permit_impl.on_register_as_inactive();
-    // Implies _inactive_reads.empty(), we don't queue new readers before
+    // Implies !has_inactive_reads(), we don't queue new readers before
     // evicting all inactive reads.
     // Checking the _wait_list covers the count resources only, so check memory
     // separately.
@@ -675,7 +698,11 @@ reader_concurrency_semaphore::inactive_read_handle reader_concurrency_semaphore:
       try {
         auto irp = std::make_unique<inactive_read>(std::move(reader));
         auto& ir = *irp;
-        _inactive_reads.push_back(ir);
+        if (ef) {
+            _evict_first_inactive_reads.push_back(ir);
+        } else {
+            _inactive_reads.push_back(ir);
+        }
         ++_stats.inactive_reads;
         return inactive_read_handle(*this, *irp.release());
       } catch (...) {
@@ -733,19 +760,19 @@ flat_mutation_reader_v2_opt reader_concurrency_semaphore::unregister_inactive_re
 }
 
 bool reader_concurrency_semaphore::try_evict_one_inactive_read(evict_reason reason) {
-    if (_inactive_reads.empty()) {
+    if (!has_inactive_reads()) {
         return false;
     }
-    evict(_inactive_reads.front(), reason);
+    evict(next_inactive_read_to_evict(), reason);
     return true;
 }
 
 void reader_concurrency_semaphore::clear_inactive_reads() {
-    while (!_inactive_reads.empty()) {
-        auto& ir = _inactive_reads.front();
+    while (has_inactive_reads()) {
+        auto& ir = next_inactive_read_to_evict();
         close_reader(std::move(ir.reader));
         // Destroying the read unlinks it too.
-        std::unique_ptr<inactive_read> _(&*_inactive_reads.begin());
+        std::unique_ptr<inactive_read> _(&ir);
     }
 }
 
@@ -828,7 +855,7 @@ std::exception_ptr reader_concurrency_semaphore::check_queue_size(std::string_vi
     return {};
 }
 
-future<> reader_concurrency_semaphore::enqueue_waiter(reader_permit permit, read_func func) {
+future<> reader_concurrency_semaphore::enqueue_waiter(reader_permit permit, read_func func, admission_lane lane) {
     if (auto ex = check_queue_size("wait")) {
         return make_exception_future<>(std::move(ex));
     }
@@ -836,8 +863,11 @@ future<> reader_concurrency_semaphore::enqueue_waiter(reader_permit permit, read
     auto fut = pr.get_future();
     permit.on_waiting();
     auto timeout = permit.timeout();
-    _wait_list.push_back(entry(std::move(pr), std::move(permit), std::move(func)), timeout);
+    _wait_list.push_back(entry(std::move(pr), std::move(permit), std::move(func), lane), timeout);
     ++_stats.reads_enqueued;
+    if (lane == admission_lane::light) {
+        ++_stats.light_reads_enqueued;
+    }
     return fut;
 }
 
@@ -845,30 +875,42 @@ void reader_concurrency_semaphore::evict_readers_in_background() {
     // Evict inactive readers in the background while wait list isn't empty
     // This is safe since stop() closes _gate;
     (void)with_gate(_close_readers_gate, [this] {
-        return do_until([this] { return _wait_list.empty() || _inactive_reads.empty(); }, [this] {
-            return detach_inactive_reader(_inactive_reads.front(), evict_reason::permit).close();
+        return do_until([this] { return _wait_list.empty() || !has_inactive_reads(); }, [this] {
+            return detach_inactive_reader(next_inactive_read_to_evict(), evict_reason::permit).close();
         });
     });
  }
 
-future<> reader_concurrency_semaphore::do_wait_admission(reader_permit permit, read_func func) {
+reader_concurrency_semaphore::admission_lane reader_concurrency_semaphore::estimate_lane(lane_func& lane) noexcept {
+    if (!lane) {
+        return admission_lane::heavy;
+    }
+    try {
+        return lane();
+    } catch (...) {
+        rcslog.debug("Failed to estimate the admission lane of a read, assuming heavy: {}", std::current_exception());
+        return admission_lane::heavy;
+    }
+}
+
+future<> reader_concurrency_semaphore::do_wait_admission(reader_permit permit, read_func func, lane_func lane) {
     if (!_execution_loop_future) {
         _execution_loop_future.emplace(execution_loop());
     }
     if (!_wait_list.empty() || !_ready_list.empty()) {
-        return enqueue_waiter(std::move(permit), std::move(func));
+        return enqueue_waiter(std::move(permit), std::move(func), estimate_lane(lane));
     }
 
     if (!has_available_units(permit.base_resources())) {
-        auto fut = enqueue_waiter(std::move(permit), std::move(func));
-        if (!_inactive_reads.empty()) {
+        auto fut = enqueue_waiter(std::move(permit), std::move(func), estimate_lane(lane));
+        if (has_inactive_reads()) {
             evict_readers_in_background();
         }
         return fut;
     }
 
     if (!all_used_permits_are_stalled()) {
-        return enqueue_waiter(std::move(permit), std::move(func));
+        return enqueue_waiter(std::move(permit), std::move(func), estimate_lane(lane));
     }
 
     permit.on_admission();
@@ -885,6 +927,8 @@ void reader_concurrency_semaphore::maybe_admit_waiters() noexcept {
         try {
             x.permit.on_admission();
             ++_stats.reads_admitted;
+            auto wait = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - x.enqueued_at).count();
+            (x.lane == admission_lane::light ? _stats.light_reads_queue_wait_us : _stats.heavy_reads_queue_wait_us) += wait;
             if (x.func) {
                 _ready_list.push(std::move(x));
             } else {
@@ -957,8 +1001,8 @@ reader_permit reader_concurrency_semaphore::make_tracking_only_permit(const sche
 }
 
 future<> reader_concurrency_semaphore::with_permit(const schema* const schema, const char* const op_name, size_t memory,
-        db::timeout_clock::time_point timeout, read_func func) {
-    return do_wait_admission(reader_permit(*this, schema, std::string_view(op_name), {1, static_cast<ssize_t>(memory)}, timeout), std::move(func));
+        db::timeout_clock::time_point timeout, read_func func, lane_func lane) {
+    return do_wait_admission(reader_permit(*this, schema, std::string_view(op_name), {1, static_cast<ssize_t>(memory)}, timeout), std::move(func), std::move(lane));
 }
 
 future<> reader_concurrency_semaphore::with_ready_permit(reader_permit permit, read_func func) {
@@ -13,6 +13,7 @@
 #include <seastar/core/gate.hh>
 #include <seastar/core/queue.hh>
 #include <seastar/core/expiring_fifo.hh>
+#include <seastar/util/bool_class.hh>
 #include "reader_permit.hh"
 #include "readers/flat_mutation_reader_v2.hh"
 
@@ -29,7 +30,7 @@ using namespace seastar;
 /// The semaphore can be configured with the desired limits on
 /// construction. New readers will only be admitted when there is both
 /// enough count and memory units available. Readers are admitted in
-/// FIFO order.
+/// FIFO order within their admission lane, see \ref admission_lane.
 /// Semaphore's `name` must be provided in ctor and its only purpose is
 /// to increase readability of exceptions: both timeout exceptions and
 /// queue overflow exceptions (read below) include this `name` in messages.
@@ -58,6 +59,21 @@ class reader_concurrency_semaphore {
 
     using eviction_notify_handler = noncopyable_function<void(evict_reason)>;
 
+    using evict_first = bool_class<class evict_first_tag>;
+
+    /// The admission queue is made of one FIFO per lane.
+    ///
+    /// Light reads are admitted ahead of queued heavy reads, so that a few
+    /// expensive reads cannot make cheap ones wait behind them, but at least
+    /// one heavy read is admitted for every `light_lane_weight` light ones,
+    /// so heavy reads are not starved either. It is up to the caller to
+    /// estimate the cost of a read, unless told otherwise reads are heavy.
+    enum class admission_lane {
+        light,
+        heavy,
+    };
+    static constexpr unsigned light_lane_weight = 4;
+
     struct stats {
         // The number of inactive reads evicted to free up permits.
         uint64_t permit_based_evictions = 0;
@@ -75,6 +91,12 @@ class reader_concurrency_semaphore {
         uint64_t reads_admitted = 0;
         // Total number of reads enqueued to wait for admission.
         uint64_t reads_enqueued = 0;
+        // Total number of reads enqueued to wait for admission in the light lane.
+        uint64_t light_reads_enqueued = 0;
+        // Total time reads admitted from the light lane spent waiting for admission, in microseconds.
+        uint64_t light_reads_queue_wait_us = 0;
+        // Total time reads admitted from the heavy lane spent waiting for admission, in microseconds.
+        uint64_t heavy_reads_queue_wait_us = 0;
         // Total number of permits created so far.
         uint64_t total_permits = 0;
         // Current number of permits.
@@ -93,14 +115,22 @@ class reader_concurrency_semaphore {
     class inactive_read_handle;
 
     using read_func = noncopyable_function<future<>(reader_permit)>;
+    /// Estimates the admission lane of a read. Only called if the read has to
+    /// wait for admission, so it may be more expensive than admitting a read.
+    /// Reads without an estimate are heavy.
+    using lane_func = noncopyable_function<admission_lane()>;
 
 private:
     struct entry {
         promise<> pr;
         reader_permit permit;
         read_func func;
+        admission_lane lane = admission_lane::heavy;
+        std::chrono::steady_clock::time_point enqueued_at;
         entry(promise<>&& pr, reader_permit permit, read_func func)
             : pr(std::move(pr)), permit(std::move(permit)), func(std::move(func)) {}
+        entry(promise<>&& pr, reader_permit permit, read_func func, admission_lane lane)
+            : pr(std::move(pr)), permit(std::move(permit)), func(std::move(func)), lane(lane), enqueued_at(std::chrono::steady_clock::now()) {}
     };
 
     class expiry_handler {
@@ -126,6 +156,46 @@ class reader_concurrency_semaphore {
 
     using inactive_reads_type = bi::list<inactive_read, bi::constant_time_size<false>>;
 
+    // The admission queue, see admission_lane.
+    class wait_queue {
+        using fifo_type = expiring_fifo<entry, expiry_handler, db::timeout_clock>;
+        fifo_type _light;
+        fifo_type _heavy;
+        unsigned _light_admitted_in_a_row = 0;
+    private:
+        bool heavy_is_next() const noexcept {
+            return _light.empty() || (!_heavy.empty() && _light_admitted_in_a_row >= light_lane_weight);
+        }
+    public:
+        explicit wait_queue(reader_concurrency_semaphore& semaphore)
+            : _light(expiry_handler(semaphore))
+            , _heavy(expiry_handler(semaphore))
+        { }
+        bool empty() const noexcept {
+            return _light.empty() && _heavy.empty();
+        }
+        size_t size() const noexcept {
+            return _light.size() + _heavy.size();
+        }
+        void push_back(entry&& e, db::timeout_clock::time_point timeout) {
+            auto& fifo = e.lane == admission_lane::light ? _light : _heavy;
+            fifo.push_back(std::move(e), timeout);
+        }
+        // The waiter to be admitted next, the queue must not be empty.
+        entry& front() noexcept {
+            return heavy_is_next() ? _heavy.front() : _light.front();
+        }
+        void pop_front() noexcept {
+            if (heavy_is_next()) {
+                _heavy.pop_front();
+                _light_admitted_in_a_row = 0;
+            } else {
+                _light.pop_front();
+                ++_light_admitted_in_a_row;
+            }
+        }
+    };
+
 public:
     class inactive_read_handle {
         reader_concurrency_semaphore* _sem = nullptr;
@@ -173,12 +243,15 @@ class reader_concurrency_semaphore {
     const resources _initial_resources;
     resources _resources;
 
-    expiring_fifo<entry, expiry_handler, db::timeout_clock> _wait_list;
+    wait_queue _wait_list;
     queue<entry> _ready_list;
 
     sstring _name;
     size_t _max_queue_length = std::numeric_limits<size_t>::max();
     inactive_reads_type _inactive_reads;
+    // Inactive reads registered with evict_first::yes, evicted before
+    // _inactive_reads. Both lists are in registration order.
+    inactive_reads_type _evict_first_inactive_reads;
     stats _stats;
     permit_list_type _permit_list;
     bool _stopped = false;
@@ -198,9 +271,10 @@ class reader_concurrency_semaphore {
 
     // Add the permit to the wait queue and return the future which resolves when
     // the permit is admitted (popped from the queue).
-    future<> enqueue_waiter(reader_permit permit, read_func func);
+    future<> enqueue_waiter(reader_permit permit, read_func func, admission_lane lane);
     void evict_readers_in_background();
-    future<> do_wait_admission(reader_permit permit, read_func func = {});
+    static admission_lane estimate_lane(lane_func& lane) noexcept;
+    future<> do_wait_admission(reader_permit permit, read_func func = {}, lane_func lane = {});
     void maybe_admit_waiters() noexcept;
 
     void on_permit_created(reader_permit::impl&);
@@ -272,7 +346,11 @@ class reader_concurrency_semaphore {
     ///
     /// The semaphore takes ownership of the passed in reader for the duration
     /// of its inactivity and it may evict it to free up resources if necessary.
-    inactive_read_handle register_inactive_read(flat_mutation_reader_v2 ir) noexcept;
+    ///
+    /// Inactive reads are evicted oldest first, except that those registered
+    /// with evict_first::yes are evicted, also oldest first, before all others.
+    /// Use it for reads which are less likely to be resumed.
+    inactive_read_handle register_inactive_read(flat_mutation_reader_v2 ir, evict_first ef = evict_first::no) noexcept;
 
     /// Set the inactive read eviction notification handler and optionally eviction ttl.
     ///
@@ -303,6 +381,14 @@ class reader_concurrency_semaphore {
     /// Clear all inactive reads.
     void clear_inactive_reads();
 private:
+    bool has_inactive_reads() const noexcept {
+        return !_evict_first_inactive_reads.empty() || !_inactive_reads.empty();
+    }
+    // The inactive read to evict next, has_inactive_reads() must be true.
+    inactive_read& next_inactive_read_to_evict() noexcept {
+        return _evict_first_inactive_reads.empty() ? _inactive_reads.front() : _evict_first_inactive_reads.front();
+    }
+
     // The following two functions are extension points for
     // future inheriting classes that needs to run some stop
     // logic just before or just after the current stop logic.
@@ -376,7 +462,10 @@ class reader_concurrency_semaphore {
     ///
     /// Some permits cannot be associated with any table, so passing nullptr as
     /// the schema parameter is allowed.
-    future<> with_permit(const schema* const schema, const char* const op_name, size_t memory, db::timeout_clock::time_point timeout, read_func func);
+    ///
+    /// If the read has to wait for admission, it waits in the lane returned by \ref lane.
+    future<> with_permit(const schema* const schema, const char* const op_name, size_t memory, db::timeout_clock::time_point timeout, read_func func,
+            lane_func lane = {});
 
     /// Run the function through the semaphore's execution stage with a pre-admitted permit
     ///
@@ -161,6 +161,11 @@ class reader_permit {
 
     query::max_result_size max_result_size() const;
     void set_max_result_size(query::max_result_size);
+
+    // The number of pages of a paged query this permit served and which were
+    // followed by saving the read for the next page.
+    uint64_t saved_pages() const noexcept;
+    void on_page_saved() noexcept;
 };
 
 using reader_permit_opt = optimized_optional<reader_permit>;
@@ -22,6 +22,7 @@
 #include <seastar/core/coroutine.hh>
 #include <seastar/coroutine/parallel_for_each.hh>
 #include <seastar/coroutine/as_future.hh>
+#include <seastar/coroutine/maybe_yield.hh>
 #include <seastar/core/reactor.hh>
 #include <seastar/core/metrics.hh>
 #include <boost/algorithm/string/erase.hpp>
@@ -71,6 +72,7 @@
 #include "readers/multishard.hh"
 
 #include "lang/wasm.hh"
+#include "tracing/stage_latencies.hh"
 
 using namespace std::chrono_literals;
 using namespace db;
@@ -367,6 +369,7 @@ database::database(const db::config& cfg, database_config dbcfg, service::migrat
     , _system_sstables_manager(std::make_unique<sstables::sstables_manager>(*_nop_large_data_handler, _cfg, feat, _row_cache_tracker))
     , _result_memory_limiter(dbcfg.available_memory / 10)
     , _data_listeners(std::make_unique<db::data_listeners>())
+    , _hot_partitions(std::make_unique<db::hot_partitions_tracker>(*_data_listeners))
     , _mnotifier(mn)
     , _feat(feat)
     , _shared_token_metadata(stm)
@@ -543,6 +546,9 @@ database::setup_metrics() {
                        sm::description("Counts sstables that survived the clustering key filtering. "
                                        "High value indicates that bloom filter is not very efficient and still have to access a lot of sstables to get data.")),
 
+        sm::make_counter("partition_tombstone_skipped_sstables", _cf_stats.sstables_skipped_by_partition_tombstone,
+                       sm::description("Counts sstables skipped by single partition reads because their data was shadowed by a partition tombstone of another sstable.")),
+
         sm::make_counter("dropped_view_updates", _cf_stats.dropped_view_updates,
                        sm::description("Counts the number of view updates that have been dropped due to cluster overload. ")),
 
@@ -562,6 +568,9 @@ database::setup_metrics() {
         sm::make_counter("total_writes_rate_limited", _stats->total_writes_rate_limited,
                        sm::description("Counts write operations which were rejected on the replica side because the per-partition limit was reached.")),
 
+        sm::make_counter("total_counter_updates_coalesced", _stats->total_counter_updates_coalesced,
+                       sm::description("Counts counter updates which were merged into a read-modify-write of another update to the same partition.")),
+
         sm::make_counter("total_reads", _read_concurrency_sem.get_stats().total_successful_reads,
                        sm::description("Counts the total number of successful user reads on this shard."),
                        {user_label_instance}),
@@ -642,6 +651,19 @@ database::setup_metrics() {
                                        " When the queue is full, excessive reads are shed to avoid overload."),
                        {user_label_instance}),
 
+        sm::make_counter("light_reads_enqueued", _read_concurrency_sem.get_stats().light_reads_enqueued,
+                       sm::description("The number of reads estimated to be cheap which had to wait for admission."
+                                       " These wait in a separate lane, ahead of more expensive reads."),
+                       {user_label_instance}),
+
+        sm::make_counter("light_reads_queue_wait_us", _read_concurrency_sem.get_stats().light_reads_queue_wait_us,
+                       sm::description("The total time reads estimated to be cheap spent waiting for admission, in microseconds."),
+                       {user_label_instance}),
+
+        sm::make_counter("heavy_reads_queue_wait_us", _read_concurrency_sem.get_stats().heavy_reads_queue_wait_us,
+                       sm::description("The total time reads not estimated to be cheap spent waiting for admission, in microseconds."),
+                       {user_label_instance}),
+
         sm::make_gauge("active_reads", [this] { return max_count_streaming_concurrent_reads - _streaming_concurrency_sem.available_resources().count; },
                        sm::description("Holds the number of currently active read operations issued on behalf of streaming "),
                        {streaming_label_instance}),
@@ -1479,8 +1501,10 @@ database::query(schema_ptr s, const query::read_command& cmd, query::result_opti
     auto read_func = [&, this] (reader_permit permit) {
         reader_permit::used_guard ug{permit};
         permit.set_max_result_size(max_result_size);
-        return cf.query(std::move(s), std::move(permit), cmd, opts, ranges, trace_state, get_result_memory_limiter(),
-                timeout, &querier_opt).then([&result, ug = std::move(ug)] (lw_shared_ptr<query::result> res) {
+        return tracing::sample_stage(tracing::stage::replica_read, [&] {
+            return cf.query(std::move(s), std::move(permit), cmd, opts, ranges, trace_state, get_result_memory_limiter(),
+                    timeout, &querier_opt);
+        }).then([&result, ug = std::move(ug)] (lw_shared_ptr<query::result> res) {
             result = std::move(res);
         });
     };
@@ -1492,7 +1516,9 @@ database::query(schema_ptr s, const query::read_command& cmd, query::result_opti
         if (querier_opt) {
             f = co_await coroutine::as_future(semaphore.with_ready_permit(querier_opt->permit(), read_func));
         } else {
-            f = co_await coroutine::as_future(semaphore.with_permit(s.get(), "data-query", cf.estimate_read_memory_cost(), timeout, read_func));
+            // Only reads which have to queue pay for estimating their lane.
+            f = co_await coroutine::as_future(semaphore.with_permit(s.get(), "data-query", cf.estimate_read_memory_cost(), timeout, read_func,
+                    [&cf, &cmd, &ranges] { return cf.estimate_read_admission_lane(cmd, ranges); }));
         }
 
         if (!f.failed()) {
@@ -1514,6 +1540,9 @@ database::query(schema_ptr s, const query::read_command& cmd, query::result_opti
         co_return coroutine::exception(std::move(ex));
     }
 
+    if (auto rows = result->row_count()) {
+        cf.note_read_rows(cmd, *rows);
+    }
     auto hit_rate = cf.get_global_cache_hit_rate();
     ++semaphore.get_stats().total_successful_reads;
     _stats->short_data_queries += bool(result->is_short_read());
@@ -1635,6 +1664,67 @@ future<mutation> database::do_apply_counter_update(column_family& cf, const froz
     auto m = fm.unfreeze(m_schema);
     m.upgrade(cf.schema());
 
+    // Updates to the same partition serialize on the counter cell locks and each
+    // of them pays for a read. Instead of queueing on the locks, updates arriving
+    // while a read-modify-write of their partition is in progress are merged (the
+    // deltas of a counter cell add up) and applied by a single read-modify-write
+    // once the current one is done. Every merged update gets the resulting mutation,
+    // which carries the shards of all of them; replicating it more than once is
+    // harmless since counter shards are merged by their logical clock.
+    auto& batches = cf.counter_update_batches();
+    auto it = batches.find(m.decorated_key());
+    if (it == batches.end()) {
+        auto key = m.decorated_key();
+        auto op = cf.write_in_progress();
+        batches.emplace(key, nullptr);
+        // The entry must be removed even if the update fails synchronously, or
+        // later updates of the partition would join a batch that never runs.
+        return futurize_invoke([&] {
+            return apply_counter_update_batch(cf, std::move(m), timeout, std::move(trace_state));
+        }).finally([this, &cf, key = std::move(key), op = std::move(op)] {
+            start_next_counter_update_batch(cf, key);
+        });
+    }
+    auto& batch = it->second;
+    if (!batch) {
+        batch = make_lw_shared<table::counter_update_batch>(std::move(m), timeout, trace_state);
+    } else {
+        batch->m.apply(std::move(m));
+        batch->timeout = std::max(batch->timeout, timeout);
+        ++batch->updates;
+        ++_stats->total_counter_updates_coalesced;
+    }
+    tracing::trace(trace_state, "Waiting for a counter update of the same partition, coalesced with {} other updates", batch->updates - 1);
+    return batch->result.get_shared_future(timeout);
+}
+
+void database::start_next_counter_update_batch(column_family& cf, const dht::decorated_key& key) {
+    auto& batches = cf.counter_update_batches();
+    auto it = batches.find(key);
+    assert(it != batches.end());
+    if (!it->second) {
+        batches.erase(it);
+        return;
+    }
+    // The entry stays, marking the batch as in progress.
+    auto batch = std::exchange(it->second, nullptr);
+    (void)futurize_invoke([&] {
+        // The merged mutation may predate a schema change.
+        batch->m.upgrade(cf.schema());
+        return apply_counter_update_batch(cf, batch->m, batch->timeout, batch->trace_state);
+    }).then_wrapped([batch] (future<mutation> f) {
+        if (f.failed()) {
+            batch->result.set_exception(f.get_exception());
+        } else {
+            batch->result.set_value(f.get0());
+        }
+    }).finally([this, &cf, key, op = cf.write_in_progress()] {
+        start_next_counter_update_batch(cf, key);
+    });
+}
+
+future<mutation> database::apply_counter_update_batch(column_family& cf, mutation m,
+                                                      db::timeout_clock::time_point timeout, tracing::trace_state_ptr trace_state) {
     // prepare partition slice
     query::column_id_vector static_columns;
     static_columns.reserve(m.partition().static_row().size());
@@ -2234,6 +2324,81 @@ void database::revert_initial_system_read_concurrency_boost() {
     dblog.debug("Reverted system read concurrency from initial {} to normal {}", database::max_count_concurrent_reads, database::max_count_system_concurrent_reads);
 }
 
+void database::start_loading_deferred_sstable_filters() {
+    _deferred_sstable_filters_loaded = load_deferred_sstable_filters();
+}
+
+future<> database::load_deferred_sstable_filters() {
+    // Re-pick the hottest table after every batch, so a table which starts
+    // serving reads does not wait for the filters of a large cold table.
+    static constexpr size_t max_sstables_per_batch = 64;
+    // Failures on sstables which are still in use. Failures on sstables
+    // removed by a concurrent compaction are expected and not counted.
+    static constexpr unsigned max_failures_per_table = 3;
+    std::unordered_set<utils::UUID> done;
+    // Generations of the sstables whose filter failed to load, per table.
+    std::unordered_map<utils::UUID, std::unordered_set<sstables::generation_type>> failed;
+    size_t loaded = 0;
+    while (!_shutdown) {
+        co_await coroutine::maybe_yield();
+        lw_shared_ptr<table> hottest;
+        for (auto& [id, t] : _column_families) {
+            if (!done.contains(id) && (!hottest || t->get_stats().reads.hist.count > hottest->get_stats().reads.hist.count)) {
+                hottest = t;
+            }
+        }
+        if (!hottest) {
+            break;
+        }
+        auto& table_failed = failed[hottest->schema()->id()];
+        std::vector<sstables::shared_sstable> pending;
+        auto collect_pending = [&pending, &table_failed] (const sstable_list& ssts) {
+            for (auto& sst : ssts) {
+                if (!sst->filter_loaded() && !table_failed.contains(sst->generation()) && pending.size() < max_sstables_per_batch) {
+                    pending.push_back(sst);
+                }
+            }
+        };
+        collect_pending(*hottest->get_sstables());
+        collect_pending(*hottest->maintenance_sstable_set().all());
+        if (pending.empty()) {
+            done.insert(hottest->schema()->id());
+            continue;
+        }
+        auto in_use = [&hottest] (const sstables::shared_sstable& sst) {
+            return hottest->get_sstables()->contains(sst) || hottest->maintenance_sstable_set().all()->contains(sst);
+        };
+        co_await max_concurrent_for_each(pending, _cfg.initial_sstable_loading_concurrency(), [&] (sstables::shared_sstable& sst) {
+            if (!in_use(sst)) {
+                return make_ready_future<>();
+            }
+            return with_semaphore(_sst_dir_semaphore.local(), 1, [sst] {
+                return sst->load_filter();
+            }).then_wrapped([&] (future<> f) {
+                if (!f.failed()) {
+                    ++loaded;
+                    return;
+                }
+                auto ex = f.get_exception();
+                if (!in_use(sst)) {
+                    // Compacted away while its filter was being loaded.
+                    return;
+                }
+                // The sstable keeps working without a filter, don't retry it.
+                dblog.warn("Failed to load the bloom filter of {}: {}", sst->get_filename(), ex);
+                table_failed.insert(sst->generation());
+            });
+        });
+        if (table_failed.size() >= max_failures_per_table) {
+            dblog.warn("Giving up loading the bloom filters of {}.{} after {} failures", hottest->schema()->ks_name(), hottest->schema()->cf_name(), table_failed.size());
+            done.insert(hottest->schema()->id());
+        }
+    }
+    if (loaded) {
+        dblog.info("Loaded the bloom filters of {} sstables deferred during startup", loaded);
+    }
+}
+
 future<> database::start() {
     _large_data_handler->start();
     // We need the compaction manager ready early so we can reshard.
@@ -2244,6 +2409,7 @@ future<> database::start() {
 future<> database::shutdown() {
     _shutdown = true;
     auto b = defer([this] { _stop_barrier.abort(); });
+    co_await std::exchange(_deferred_sstable_filters_loaded, make_ready_future<>());
     co_await _compaction_manager->stop();
     co_await _stop_barrier.arrive_and_wait();
     b.cancel();
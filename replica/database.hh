@@ -67,6 +67,7 @@
 #include "utils/cross-shard-barrier.hh"
 #include "sstables/generation_type.hh"
 #include "db/rate_limiter.hh"
+#include "replica/read_cost_history.hh"
 #include "db/per_partition_rate_limit_info.hh"
 #include "db/operation_type.hh"
 #include "utils/serialized_action.hh"
@@ -120,6 +121,7 @@ class config;
 class extensions;
 class rp_handle;
 class data_listeners;
+class hot_partitions_tracker;
 class large_data_handler;
 class system_keyspace;
 class table_selector;
@@ -301,6 +303,9 @@ struct cf_stats {
     int64_t clustering_filter_fast_path_count = 0;
     // how many sstables survived the clustering key checks
     int64_t surviving_sstables_after_clustering_filter = 0;
+    // how many sstables were skipped by single partition reads because they were
+    // shadowed by a partition tombstone of another sstable
+    int64_t sstables_skipped_by_partition_tombstone = 0;
 
     // How many view updates were dropped due to overload.
     int64_t dropped_view_updates = 0;
@@ -457,6 +462,23 @@ class table : public enable_lw_shared_from_this<table> {
     std::vector<view_ptr> _views;
 
     std::unique_ptr<cell_locker> _counter_cell_locks; // Memory-intensive; allocate only when needed.
+public:
+    // Counter updates to a partition which arrive while a read-modify-write of
+    // that partition is in progress, merged into a single update.
+    struct counter_update_batch {
+        mutation m;
+        db::timeout_clock::time_point timeout;
+        tracing::trace_state_ptr trace_state;
+        shared_promise<mutation> result;
+        size_t updates = 1;
+
+        counter_update_batch(mutation m, db::timeout_clock::time_point timeout, tracing::trace_state_ptr trace_state)
+            : m(std::move(m)), timeout(timeout), trace_state(std::move(trace_state)) { }
+    };
+private:
+    // Holds an entry for every partition with a counter read-modify-write in
+    // progress. The entry points to the updates waiting for it to complete, if any.
+    std::map<dht::decorated_key, lw_shared_ptr<counter_update_batch>, dht::decorated_key::less_comparator> _counter_update_batches;
 
     // Labels used to identify writes and reads for this table in the rate_limiter structure.
     db::rate_limiter::label _rate_limiter_label_for_writes;
@@ -469,6 +491,8 @@ class table : public enable_lw_shared_from_this<table> {
     // recalculated periodically
     cache_temperature _global_cache_hit_rate = cache_temperature(0.0f);
 
+    read_cost_history _read_cost_history;
+
     // holds cache hit rates per each node in a cluster
     // may not have information for some node, since it fills
     // in dynamically
@@ -769,6 +793,10 @@ class table : public enable_lw_shared_from_this<table> {
 
     future<std::vector<locked_cell>> lock_counter_cells(const mutation& m, db::timeout_clock::time_point timeout);
 
+    auto& counter_update_batches() {
+        return _counter_update_batches;
+    }
+
     logalloc::occupancy_stats occupancy() const;
 private:
     table(schema_ptr schema, config cfg, db::commitlog* cl, compaction_manager&, sstables::sstables_manager&, cell_locker_stats& cl_stats, cache_tracker& row_cache_tracker);
@@ -1054,6 +1082,14 @@ class table : public enable_lw_shared_from_this<table> {
 
     size_t estimate_read_memory_cost() const;
 
+    // Chooses the admission lane of a data query, from the shape of the
+    // command, how many rows reads of the same shape returned recently and,
+    // for single partition reads, whether the partition is cached or else
+    // how many sstables may have to be read.
+    reader_concurrency_semaphore::admission_lane estimate_read_admission_lane(const query::read_command& cmd, const dht::partition_range_vector& ranges);
+    // Feeds the result of a data query back into estimate_read_admission_lane().
+    void note_read_rows(const query::read_command& cmd, uint64_t rows);
+
 private:
     future<row_locker::lock_holder> do_push_view_replica_updates(schema_ptr s, mutation m, db::timeout_clock::time_point timeout, mutation_source source,
             tracing::trace_state_ptr tr_state, reader_concurrency_semaphore& sem, const io_priority_class& io_priority, query::partition_slice::option_set custom_opts) const;
@@ -1274,6 +1310,7 @@ class database : public peering_sharded_service<database> {
         uint64_t total_writes_failed = 0;
         uint64_t total_writes_timedout = 0;
         uint64_t total_writes_rate_limited = 0;
+        uint64_t total_counter_updates_coalesced = 0;
         uint64_t total_reads = 0;
         uint64_t total_reads_failed = 0;
         uint64_t total_reads_rate_limited = 0;
@@ -1348,6 +1385,7 @@ class database : public peering_sharded_service<database> {
 
     friend db::data_listeners;
     std::unique_ptr<db::data_listeners> _data_listeners;
+    std::unique_ptr<db::hot_partitions_tracker> _hot_partitions;
 
     service::migration_notifier& _mnotifier;
     gms::feature_service& _feat;
@@ -1355,6 +1393,7 @@ class database : public peering_sharded_service<database> {
     const locator::shared_token_metadata& _shared_token_metadata;
 
     sharded<semaphore>& _sst_dir_semaphore;
+    future<> _deferred_sstable_filters_loaded = make_ready_future<>();
 
     std::unique_ptr<wasm::engine> _wasm_engine;
     utils::cross_shard_barrier _stop_barrier;
@@ -1386,6 +1425,7 @@ class database : public peering_sharded_service<database> {
 private:
     future<> flush_non_system_column_families();
     future<> flush_system_column_families();
+    future<> load_deferred_sstable_filters();
 
     using system_keyspace = bool_class<struct system_keyspace_tag>;
     future<> create_in_memory_keyspace(const lw_shared_ptr<keyspace_metadata>& ksm, locator::effective_replication_map_factory& erm_factory, system_keyspace system);
@@ -1399,6 +1439,9 @@ class database : public peering_sharded_service<database> {
 
     future<mutation> do_apply_counter_update(column_family& cf, const frozen_mutation& fm, schema_ptr m_schema, db::timeout_clock::time_point timeout,
                                              tracing::trace_state_ptr trace_state);
+    future<mutation> apply_counter_update_batch(column_family& cf, mutation m, db::timeout_clock::time_point timeout,
+                                                tracing::trace_state_ptr trace_state);
+    void start_next_counter_update_batch(column_family& cf, const dht::decorated_key& key);
 
     template<typename Future>
     Future update_write_metrics(Future&& f);
@@ -1518,6 +1561,11 @@ class database : public peering_sharded_service<database> {
     /// reads, to speed up startup. After startup this should be reverted to
     /// the normal concurrency.
     void revert_initial_system_read_concurrency_boost();
+
+    /// Loads, in the background, the bloom filters of the sstables which were
+    /// opened without them during startup (see lazy_load_sstable_bloom_filters).
+    /// Tables which served the most reads so far are handled first.
+    void start_loading_deferred_sstable_filters();
     future<> start();
     future<> shutdown();
     future<> stop();
@@ -1681,6 +1729,10 @@ class database : public peering_sharded_service<database> {
         return *_data_listeners;
     }
 
+    const db::hot_partitions_tracker& hot_partitions() const {
+        return *_hot_partitions;
+    }
+
     // Get the maximum result size for an unlimited query, appropriate for the
     // query class, which is deduced from the current scheduling group.
     query::max_result_size get_unlimited_query_max_result_size() const;
@@ -233,16 +233,68 @@ highest_version_seen(sharded<sstables::sstable_directory>& dir, sstables::sstabl
     });
 }
 
+// Runs reshape jobs lent by the other shards, until none of them has any left.
+static future<uint64_t> help_reshape(sharded<sstables::sstable_directory>& dir, sharded<replica::database>& db, sstables::reshape_mode mode,
+        const sstring& ks_name, const sstring& table_name, const sstables::compaction_sstable_creator_fn& creator,
+        const std::function<bool (const sstables::shared_sstable&)>& filter) {
+    uint64_t reshaped_size = 0;
+    auto& table = db.local().find_column_family(ks_name, table_name);
+    auto& cm = db.local().get_compaction_manager();
+    for (unsigned i = 1; i < smp::count;) {
+        auto owner = (this_shard_id() + i) % smp::count;
+        auto job = co_await dir.invoke_on(owner, [&db, &ks_name, &table_name, mode, &filter] (sstables::sstable_directory& d) {
+            auto& table = db.local().find_column_family(ks_name, table_name);
+            return d.lend_reshape_job(table, mode, filter);
+        });
+        if (job.sstables.empty()) {
+            ++i;
+            continue;
+        }
+
+        std::vector<sstables::generation_type> inputs;
+        for (auto& info : job.sstables) {
+            inputs.push_back(info.generation);
+            reshaped_size += info.uncompressed_data_size;
+        }
+        sstables::sstable_directory::sstable_info_vector outputs;
+        bool succeeded = true;
+        try {
+            outputs = co_await dir.local().run_lent_reshape_job(std::move(job), cm, table, creator);
+        } catch (...) {
+            dblog.info("Reshape of SSTables lent by shard {} failed for Table {}.{} due to {}", owner, ks_name, table_name, std::current_exception());
+            succeeded = false;
+        }
+        try {
+            co_await dir.invoke_on(owner, [inputs = std::move(inputs), outputs = std::move(outputs), succeeded] (sstables::sstable_directory& d) mutable {
+                return d.complete_lent_reshape_job(std::move(inputs), std::move(outputs), succeeded);
+            });
+        } catch (...) {
+            dblog.info("Completing reshape of SSTables lent by shard {} failed for Table {}.{} due to {}", owner, ks_name, table_name, std::current_exception());
+            succeeded = false;
+        }
+        if (!succeeded) {
+            break;
+        }
+    }
+    co_return reshaped_size;
+}
+
 future<>
 distributed_loader::reshape(sharded<sstables::sstable_directory>& dir, sharded<replica::database>& db, sstables::reshape_mode mode,
         sstring ks_name, sstring table_name, sstables::compaction_sstable_creator_fn creator,
         std::function<bool (const sstables::shared_sstable&)> filter) {
 
     auto start = std::chrono::steady_clock::now();
-    auto total_size = co_await dir.map_reduce0([&dir, &db, ks_name = std::move(ks_name), table_name = std::move(table_name), creator = std::move(creator), mode, filter] (sstables::sstable_directory& d) {
+    // Shards which are done with their own SSTables help the others, so that a
+    // backlog concentrated on a few shards does not leave the other cores idle.
+    auto total_size = co_await dir.map_reduce0([&dir, &db, &ks_name, &table_name, &creator, mode, &filter] (sstables::sstable_directory& d) {
         auto& table = db.local().find_column_family(ks_name, table_name);
         auto& cm = db.local().get_compaction_manager();
-        return d.reshape(cm, table, creator, mode, filter);
+        return d.reshape(cm, table, creator, mode, filter).then([&dir, &db, &ks_name, &table_name, &creator, mode, &filter] (uint64_t size) {
+            return help_reshape(dir, db, mode, ks_name, table_name, creator, filter).then([size] (uint64_t helped_size) {
+                return size + helped_size;
+            });
+        });
     }, uint64_t(0), std::plus<uint64_t>());
 
     if (total_size > 0) {
@@ -466,7 +518,8 @@ future<> distributed_loader::populate_column_family(distributed<replica::databas
             sstables::sstable_directory::allow_loading_materialized_view::yes,
             [&global_table] (fs::path dir, sstables::generation_type gen, sstables::sstable_version_types v, sstables::sstable_format_types f) {
                 return global_table->make_sstable(dir.native(), gen, v, f);
-        }).get();
+            },
+            sstables::sstable_directory::lazy_filter_loading(db.local().get_config().lazy_load_sstable_bloom_filters())).get();
 
         auto stop = deferred_stop(directory);
 
@@ -673,6 +726,8 @@ future<> distributed_loader::init_non_system_keyspaces(distributed<replica::data
                 return make_ready_future<>();
             });
         }).get();
+
+        db.invoke_on_all(&replica::database::start_loading_deferred_sstable_filters).get();
     });
 }
 
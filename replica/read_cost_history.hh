@@ -0,0 +1,75 @@
+/*
+ * Copyright (C) 2022-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <optional>
+#include <unordered_map>
+
+#include "query-request.hh"
+#include "schema.hh"
+#include "utils/hash.hh"
+
+namespace replica {
+
+// Remembers how many rows reads of a given shape returned recently.
+//
+// The replica does not know which prepared statement a read comes from, but
+// all executions of a statement send read commands of the same shape: the
+// same slice options, columns and limits, and the same kind of clustering
+// restrictions. So the shape stands in for the statement.
+class read_cost_history {
+public:
+    using shape = size_t;
+    // Bounds the memory used by tables read in many different ways.
+    static constexpr size_t max_shapes = 1024;
+private:
+    // Exponentially weighted moving average of the rows returned per read.
+    std::unordered_map<shape, uint64_t> _rows;
+public:
+    static shape shape_of(const schema& s, const query::read_command& cmd) {
+        const auto& slice = cmd.slice;
+        const auto& row_ranges = slice.default_row_ranges();
+        const bool single_rows = std::all_of(row_ranges.begin(), row_ranges.end(), [&s] (const query::clustering_range& r) {
+            return query::is_single_row(s, r);
+        });
+        shape h = std::hash<uint64_t>()(slice.options.mask());
+        h = utils::hash_combine(h, slice.static_columns.size());
+        h = utils::hash_combine(h, slice.regular_columns.size());
+        h = utils::hash_combine(h, row_ranges.size());
+        h = utils::hash_combine(h, single_rows);
+        h = utils::hash_combine(h, std::hash<uint64_t>()(slice.partition_row_limit()));
+        h = utils::hash_combine(h, std::hash<uint64_t>()(cmd.get_row_limit()));
+        h = utils::hash_combine(h, cmd.partition_limit);
+        return h;
+    }
+
+    std::optional<uint64_t> expected_rows(shape sh) const {
+        auto it = _rows.find(sh);
+        if (it == _rows.end()) {
+            return std::nullopt;
+        }
+        return it->second;
+    }
+
+    void record(shape sh, uint64_t rows) {
+        auto it = _rows.find(sh);
+        if (it != _rows.end()) {
+            it->second = (it->second * 3 + rows) / 4;
+            return;
+        }
+        if (_rows.size() >= max_shapes) {
+            _rows.clear();
+        }
+        _rows.emplace(sh, rows);
+    }
+};
+
+} // namespace replica
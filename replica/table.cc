@@ -1182,6 +1182,7 @@ table::table(schema_ptr schema, config config, db::commitlog* cl, compaction_man
     , _sstables_manager(sst_manager)
     , _index_manager(this->as_data_dictionary())
     , _counter_cell_locks(_schema->is_counter() ? std::make_unique<cell_locker>(_schema, cl_stats) : nullptr)
+    , _counter_update_batches(dht::decorated_key::less_comparator(_schema))
     , _table_state(std::make_unique<table_state>(*this))
     , _row_locker(_schema)
     , _off_strategy_trigger([this] { trigger_offstrategy_compaction(); })
@@ -1854,6 +1855,55 @@ size_t table::estimate_read_memory_cost() const {
     return new_reader_base_cost;
 }
 
+// Reads expected to return no more rows than this are light.
+static constexpr uint64_t light_read_max_rows = 100;
+// Uncached single partition reads touching no more sstables than this are light.
+static constexpr size_t light_read_max_sstables = 4;
+
+reader_concurrency_semaphore::admission_lane
+table::estimate_read_admission_lane(const query::read_command& cmd, const dht::partition_range_vector& ranges) {
+    using admission_lane = reader_concurrency_semaphore::admission_lane;
+
+    if (ranges.size() != 1 || !query::is_single_partition(ranges.front())) {
+        return admission_lane::heavy;
+    }
+
+    if (auto rows = _read_cost_history.expected_rows(read_cost_history::shape_of(*_schema, cmd))) {
+        if (*rows > light_read_max_rows) {
+            return admission_lane::heavy;
+        }
+    } else {
+        // No history yet, go by the restrictions of the slice.
+        const auto& row_ranges = cmd.slice.default_row_ranges();
+        const bool few_rows = cmd.get_row_limit() <= light_read_max_rows
+                || _schema->clustering_key_size() == 0
+                || (row_ranges.size() <= light_read_max_rows && std::all_of(row_ranges.begin(), row_ranges.end(), [this] (const query::clustering_range& r) {
+                    return query::is_single_row(*_schema, r);
+                }));
+        if (!few_rows) {
+            return admission_lane::heavy;
+        }
+    }
+
+    auto dk = ranges.front().start()->value().as_decorated_key();
+    if (!cmd.slice.options.contains<query::partition_slice::option::bypass_cache>() && _cache.contains(dk)) {
+        return admission_lane::light;
+    }
+
+    auto hk = sstables::sstable::make_hashed_key(*_schema, dk.key());
+    size_t sstables = 0;
+    for (auto&& sst : _sstables->select(ranges.front())) {
+        if (sst->filter_has_key(hk) && ++sstables > light_read_max_sstables) {
+            return admission_lane::heavy;
+        }
+    }
+    return admission_lane::light;
+}
+
+void table::note_read_rows(const query::read_command& cmd, uint64_t rows) {
+    _read_cost_history.record(read_cost_history::shape_of(*_schema, cmd), rows);
+}
+
 void table::set_hit_rate(gms::inet_address addr, cache_temperature rate) {
     auto& e = _cluster_cache_hit_rates[addr];
     e.rate = rate;
@@ -1074,6 +1074,12 @@ void row_cache::refresh_snapshot() {
     _underlying = _snapshot_source();
 }
 
+bool row_cache::contains(const dht::decorated_key& dk) {
+    return _read_section(_tracker.region(), [&] {
+        return _partitions.find(dk, dht::ring_position_comparator(*_schema)) != _partitions.end();
+    });
+}
+
 void row_cache::touch(const dht::decorated_key& dk) {
  _read_section(_tracker.region(), [&] {
     auto i = _partitions.find(dk, dht::ring_position_comparator(*_schema));
@@ -418,6 +418,10 @@ class row_cache final {
     // source hasn't changed.
     void refresh_snapshot();
 
+    // Returns true if the given partition is present in cache. Reading it
+    // may still need I/O if some of the rows it needs were evicted.
+    bool contains(const dht::decorated_key&);
+
     // Moves given partition to the front of LRU if present in cache.
     void touch(const dht::decorated_key&);
 
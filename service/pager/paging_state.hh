@@ -39,6 +39,7 @@ class paging_state final {
     uint32_t _rows_fetched_for_last_partition_high_bits;
     bound_weight _ck_weight = bound_weight::equal;
     partition_region _region = partition_region::partition_start;
+    uint64_t _page_byte_budget = 0;
 
 public:
     // IDL ctor
@@ -52,7 +53,8 @@ class paging_state final {
             uint32_t remaining_ext,
             uint32_t rows_fetched_for_last_partition_high_bits,
             bound_weight ck_weight,
-            partition_region region);
+            partition_region region,
+            uint64_t page_byte_budget);
 
     paging_state(partition_key pk,
             position_in_partition_view pos,
@@ -165,6 +167,18 @@ class paging_state final {
         return _last_replicas;
     }
 
+    /**
+     * The byte size of the next page, as adapted to the cost of the previous
+     * pages when adaptive paging is enabled, 0 if it was not adapted.
+     */
+    uint64_t get_page_byte_budget() const {
+        return _page_byte_budget;
+    }
+
+    void set_page_byte_budget(uint64_t budget) {
+        _page_byte_budget = budget;
+    }
+
     /**
      * The read-repair decision made for this query.
      *
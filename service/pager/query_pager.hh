@@ -75,6 +75,9 @@ class query_pager {
     paging_state::replicas_per_token_range _last_replicas;
     std::optional<db::read_repair_decision> _query_read_repair_decision;
     uint64_t _rows_fetched_for_last_partition = 0;
+    // The byte size of the next page when adaptive paging is enabled, see
+    // adapt_page_byte_budget(). 0 means the default page size.
+    uint64_t _page_byte_budget = 0;
     stats _stats;
 public:
     query_pager(service::storage_proxy& p, schema_ptr s, shared_ptr<const cql3::selection::selection> selection,
@@ -153,6 +156,9 @@ class query_pager {
     }
 
     virtual void maybe_adjust_per_partition_limit(uint32_t page_size) const { }
+
+    void adapt_page_byte_budget(std::chrono::milliseconds target_latency, std::chrono::steady_clock::duration latency,
+            const query::result& res, uint64_t default_page_size);
 };
 
 }
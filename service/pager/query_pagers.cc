@@ -15,6 +15,8 @@
 #include "cql3/restrictions/statement_restrictions.hh"
 #include "log.hh"
 #include "service/storage_proxy.hh"
+#include "replica/database.hh"
+#include "db/config.hh"
 #include "to_string.hh"
 #include "utils/result_combinators.hh"
 #include "view_info.hh"
@@ -25,6 +27,9 @@ using result = service::pager::query_pager::result<T>;
 
 static logging::logger qlogger("paging");
 
+// Adaptive paging never shrinks pages below this many bytes.
+static constexpr uint64_t min_page_byte_budget = 64 * 1024;
+
 namespace service::pager {
 
 struct noop_visitor {
@@ -68,6 +73,7 @@ future<result<service::storage_proxy::coordinator_query_result>> query_pager::do
     // Override this, to make sure we use the value appropriate for paging
     // (with allow_short_read set).
     _cmd->max_result_size = _proxy->get_max_result_size(_cmd->slice);
+    const auto default_page_size = _cmd->max_result_size->get_page_size();
 
     if (!_last_pkey && state) {
         _max = state->get_remaining();
@@ -77,6 +83,21 @@ future<result<service::storage_proxy::coordinator_query_result>> query_pager::do
         _last_replicas = state->get_last_replicas();
         _query_read_repair_decision = state->get_query_read_repair_decision();
         _rows_fetched_for_last_partition = state->get_rows_fetched_for_last_partition();
+        // The budget comes back from the client, don't trust it.
+        if (auto budget = state->get_page_byte_budget()) {
+            _page_byte_budget = std::clamp(budget, std::min(min_page_byte_budget, default_page_size), default_page_size);
+        }
+    }
+
+    // The page size is only honored by replicas with this feature, the others
+    // cut pages at the hard limit.
+    std::chrono::milliseconds target_latency(0);
+    if (_proxy->features().separate_page_size_and_safety_limit) {
+        target_latency = std::chrono::milliseconds(_proxy->local_db().get_config().adaptive_paging_target_latency_in_ms());
+    }
+    if (target_latency.count() && _page_byte_budget) {
+        _cmd->max_result_size = query::max_result_size(_cmd->max_result_size->soft_limit, _cmd->max_result_size->hard_limit,
+                std::min(_page_byte_budget, default_page_size));
     }
 
     _cmd->is_first_page = query::is_first_page(!_query_uuid);
@@ -178,11 +199,38 @@ future<result<service::storage_proxy::coordinator_query_result>> query_pager::do
 
     auto ranges = _ranges;
     auto command = ::make_lw_shared<query::read_command>(*_cmd);
-    return _proxy->query_result(_schema,
+    auto f = _proxy->query_result(_schema,
             std::move(command),
             std::move(ranges),
             _options.get_consistency(),
             {timeout, _state.get_permit(), _state.get_client_state(), _state.get_trace_state(), std::move(_last_replicas), _query_read_repair_decision});
+    if (!target_latency.count()) {
+        return f;
+    }
+    return f.then([this, target_latency, default_page_size, start = std::chrono::steady_clock::now()] (result<service::storage_proxy::coordinator_query_result> r) {
+        if (r) {
+            adapt_page_byte_budget(target_latency, std::chrono::steady_clock::now() - start, *r.value().query_result, default_page_size);
+        }
+        return r;
+    });
+}
+
+// Halves the byte size of pages slower than the target latency. Pages cut
+// short by their byte size and faster than half the target latency double it,
+// up to the default page size. Pages are always limited by the row count
+// requested by the client as well, so tiny rows are not helped past that.
+void query_pager::adapt_page_byte_budget(std::chrono::milliseconds target_latency, std::chrono::steady_clock::duration latency,
+        const query::result& res, uint64_t default_page_size) {
+    const auto budget = _page_byte_budget ? std::min(_page_byte_budget, default_page_size) : default_page_size;
+    if (latency > target_latency) {
+        _page_byte_budget = std::max(budget / 2, min_page_byte_budget);
+    } else if (latency < target_latency / 2 && res.is_short_read()) {
+        _page_byte_budget = std::min(budget * 2, default_page_size);
+    } else {
+        return;
+    }
+    qlogger.trace("Page took {}us, page byte budget {} -> {}",
+            std::chrono::duration_cast<std::chrono::microseconds>(latency).count(), budget, _page_byte_budget);
 }
 
 future<> query_pager::fetch_page(cql3::selection::result_set_builder& builder, uint32_t page_size, gc_clock::time_point now, db::timeout_clock::time_point timeout) {
@@ -422,7 +470,9 @@ void query_pager::handle_result(
 }
 
 lw_shared_ptr<const paging_state> query_pager::state() const {
-    return make_lw_shared<paging_state>(_last_pkey.value_or(partition_key::make_empty()), _last_pos, _exhausted ? 0 : _max, _cmd->query_uuid, _last_replicas, _query_read_repair_decision, _rows_fetched_for_last_partition);
+    auto state = make_lw_shared<paging_state>(_last_pkey.value_or(partition_key::make_empty()), _last_pos, _exhausted ? 0 : _max, _cmd->query_uuid, _last_replicas, _query_read_repair_decision, _rows_fetched_for_last_partition);
+    state->set_page_byte_budget(_page_byte_budget);
+    return state;
 }
 
 }
@@ -97,6 +97,7 @@
 #include "utils/exceptions.hh"
 #include "replica/exceptions.hh"
 #include "db/operation_type.hh"
+#include "tracing/stage_latencies.hh"
 
 namespace bi = boost::intrusive;
 
@@ -2504,11 +2505,13 @@ storage_proxy::mutate_with_triggers(std::vector<mutation> mutations, db::consist
     clock_type::time_point timeout,
     bool should_mutate_atomically, tracing::trace_state_ptr tr_state, service_permit permit, db::allow_per_partition_rate_limit allow_limit, bool raw_counters) {
     warn(unimplemented::cause::TRIGGERS);
-    if (should_mutate_atomically) {
-        assert(!raw_counters);
-        return mutate_atomically_result(std::move(mutations), cl, timeout, std::move(tr_state), std::move(permit));
-    }
-    return mutate_result(std::move(mutations), cl, timeout, std::move(tr_state), std::move(permit), allow_limit, raw_counters);
+    return tracing::sample_stage(tracing::stage::coordinator_write, [&] {
+        if (should_mutate_atomically) {
+            assert(!raw_counters);
+            return mutate_atomically_result(std::move(mutations), cl, timeout, std::move(tr_state), std::move(permit));
+        }
+        return mutate_result(std::move(mutations), cl, timeout, std::move(tr_state), std::move(permit), allow_limit, raw_counters);
+    });
 }
 
 /**
@@ -2789,6 +2792,15 @@ future<> storage_proxy::send_hint_to_endpoint(frozen_mutation_and_schema fm_a_s,
             allow_hints::no);
 }
 
+future<> storage_proxy::send_hint_batch_to_endpoint(std::vector<frozen_mutation_and_schema> batch, gms::inet_address target) {
+    auto timeout = clock_type::now() + std::chrono::milliseconds(_db.local().get_config().write_request_timeout_in_ms());
+    auto fms = boost::copy_range<std::vector<frozen_mutation>>(batch | boost::adaptors::transformed([] (auto& m) {
+        return std::move(m.fm);
+    }));
+    auto msg_addr = netw::messaging_service::msg_addr{ target, 0 };
+    return ser::storage_proxy_rpc_verbs::send_hint_mutation_batch(&_messaging, msg_addr, timeout, std::move(fms));
+}
+
 future<> storage_proxy::send_hint_to_all_replicas(frozen_mutation_and_schema fm_a_s) {
     if (!_features.hinted_handoff_separate_connection) {
         std::array<mutation, 1> ms{fm_a_s.fm.unfreeze(fm_a_s.s)};
@@ -4669,6 +4681,21 @@ storage_proxy::query_result(schema_ptr s,
     dht::partition_range_vector&& partition_ranges,
     db::consistency_level cl,
     storage_proxy::coordinator_query_options query_options)
+{
+    if (auto start = tracing::local_stage_latencies().maybe_start(tracing::stage::coordinator_read)) {
+        return do_query_result(std::move(s), std::move(cmd), std::move(partition_ranges), cl, std::move(query_options)).finally([start] {
+            tracing::local_stage_latencies().finish(tracing::stage::coordinator_read, start);
+        });
+    }
+    return do_query_result(std::move(s), std::move(cmd), std::move(partition_ranges), cl, std::move(query_options));
+}
+
+future<result<storage_proxy::coordinator_query_result>>
+storage_proxy::do_query_result(schema_ptr s,
+    lw_shared_ptr<query::read_command> cmd,
+    dht::partition_range_vector&& partition_ranges,
+    db::consistency_level cl,
+    storage_proxy::coordinator_query_options query_options)
 {
     if (slogger.is_enabled(logging::log_level::trace) || qlogger.is_enabled(logging::log_level::trace)) {
         static thread_local int next_id = 0;
@@ -5095,6 +5122,7 @@ void storage_proxy::init_messaging_service(shared_ptr<migration_manager> mm) {
     ser::storage_proxy_rpc_verbs::register_counter_mutation(&_messaging, std::bind_front(&storage_proxy::handle_counter_mutation, this));
     ser::storage_proxy_rpc_verbs::register_mutation(&_messaging, std::bind_front(&storage_proxy::receive_mutation_handler, this, _write_smp_service_group));
     ser::storage_proxy_rpc_verbs::register_hint_mutation(&_messaging, [this] <typename... Args>(Args&&... args) { return receive_mutation_handler(_hints_write_smp_service_group, std::forward<Args>(args)..., std::monostate()); });
+    ser::storage_proxy_rpc_verbs::register_hint_mutation_batch(&_messaging, std::bind_front(&storage_proxy::handle_hint_mutation_batch, this));
     ser::storage_proxy_rpc_verbs::register_paxos_learn(&_messaging, std::bind_front(&storage_proxy::handle_paxos_learn, this));
     ser::storage_proxy_rpc_verbs::register_mutation_done(&_messaging, std::bind_front(&storage_proxy::handle_mutation_done, this));
     ser::storage_proxy_rpc_verbs::register_mutation_failed(&_messaging, std::bind_front(&storage_proxy::handle_mutation_failed, this));
@@ -5134,6 +5162,17 @@ storage_proxy::handle_counter_mutation(const rpc::client_info& cinfo, rpc::opt_t
         });
 }
 
+future<>
+storage_proxy::handle_hint_mutation_batch(const rpc::client_info& cinfo, rpc::opt_time_point t, std::vector<frozen_mutation> fms) {
+    auto src_addr = netw::messaging_service::get_source(cinfo);
+    auto timeout = t ? *t : clock_type::now() + std::chrono::milliseconds(_db.local().get_config().write_request_timeout_in_ms());
+    get_stats().received_mutations += fms.size();
+    co_await coroutine::parallel_for_each(fms, [this, src_addr, timeout] (const frozen_mutation& fm) -> future<> {
+        schema_ptr s = co_await _mm->get_schema_for_write(fm.schema_version(), src_addr, _messaging);
+        co_await mutate_locally(s, fm, tracing::trace_state_ptr(), db::commitlog::force_sync::no, timeout, _hints_write_smp_service_group, std::monostate());
+    });
+}
+
 future<rpc::no_wait_type>
 storage_proxy::handle_write(netw::messaging_service::msg_addr src_addr, rpc::opt_time_point t,
                       utils::UUID schema_version, auto in, inet_address_vector_replica_set forward, gms::inet_address reply_to,
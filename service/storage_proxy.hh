@@ -371,6 +371,11 @@ class storage_proxy : public seastar::async_sharded_service<storage_proxy>, publ
             replicas_per_token_range preferred_replicas,
             service_permit permit);
 
+    future<result<coordinator_query_result>> do_query_result(schema_ptr,
+        lw_shared_ptr<query::read_command> cmd,
+        dht::partition_range_vector&& partition_ranges,
+        db::consistency_level cl,
+        coordinator_query_options optional_params);
     future<result<coordinator_query_result>> do_query(schema_ptr,
         lw_shared_ptr<query::read_command> cmd,
         dht::partition_range_vector&& partition_ranges,
@@ -434,6 +439,7 @@ class storage_proxy : public seastar::async_sharded_service<storage_proxy>, publ
     future<rpc::tuple<Elements..., replica::exception_variant>> encode_replica_exception_for_rpc(future<rpc::tuple<Elements...>>&& f, auto&& default_tuple_maker);
 
     future<> handle_counter_mutation(const rpc::client_info& cinfo, rpc::opt_time_point t, std::vector<frozen_mutation> fms, db::consistency_level cl, std::optional<tracing::trace_info> trace_info);
+    future<> handle_hint_mutation_batch(const rpc::client_info& cinfo, rpc::opt_time_point t, std::vector<frozen_mutation> fms);
     future<rpc::no_wait_type> handle_write(netw::msg_addr src_addr, rpc::opt_time_point t,
                       utils::UUID schema_version, auto in, inet_address_vector_replica_set forward, gms::inet_address reply_to,
                       unsigned shard, storage_proxy::response_id_type response_id, std::optional<tracing::trace_info> trace_info,
@@ -594,6 +600,11 @@ class storage_proxy : public seastar::async_sharded_service<storage_proxy>, publ
     // and use different RPC verb.
     future<> send_hint_to_endpoint(frozen_mutation_and_schema fm_a_s, gms::inet_address target);
 
+    // Send several hints to a specific remote target in a single RPC.
+    // The target applies them locally and doesn't forward them, so it has to be a replica of all of them.
+    // Must only be used if the cluster supports the HINT_MUTATION_BATCH feature.
+    future<> send_hint_batch_to_endpoint(std::vector<frozen_mutation_and_schema> batch, gms::inet_address target);
+
     /**
      * Performs the truncate operatoin, which effectively deletes all data from
      * the column family cfname
@@ -13,6 +13,7 @@
 #include <seastar/core/iostream.hh>
 #include "sstables/exceptions.hh"
 #include "sstables/progress_monitor.hh"
+#include "sstables/read_ahead_controller.hh"
 #include <seastar/core/byteorder.hh>
 #include <seastar/util/variant_utils.hh>
 #include <seastar/net/byteorder.hh>
@@ -479,6 +480,11 @@ class continuous_data_consumer : protected primitive_consumer {
     uint64_t _remain;
     std::optional<reader_permit::blocked_guard> _blocked_guard;
     bool _first_invoke = true;
+    // Fed with how the stream is consumed, if set, see set_read_ahead_controller().
+    sstables::read_ahead_controller* _read_ahead = nullptr;
+    size_t _read_ahead_buffer_size = 0;
+    // Position of the stream when it was started or last skipped.
+    uint64_t _sequential_read_start;
 public:
     using read_status = data_consumer::read_status;
 
@@ -486,7 +492,15 @@ class continuous_data_consumer : protected primitive_consumer {
             : primitive_consumer(std::move(permit))
             , _input(std::move(input))
             , _stream_position(sstables::reader_position_tracker{start, maxlen})
-            , _remain(maxlen) {}
+            , _remain(maxlen)
+            , _sequential_read_start(start) {}
+
+    // Reports skips and sequential reads to the controller which chose the
+    // read-ahead of the input stream, which must outlive this consumer.
+    void set_read_ahead_controller(sstables::read_ahead_controller& controller, size_t buffer_size) noexcept {
+        _read_ahead = &controller;
+        _read_ahead_buffer_size = buffer_size;
+    }
 
     future<> consume_input() {
         // On first invoke we are guaranteed to go to the disk, so mark as
@@ -610,6 +624,10 @@ class continuous_data_consumer : protected primitive_consumer {
     future<> fast_forward_to(size_t begin, size_t end) {
         assert(begin >= _stream_position.position);
         auto n = begin - _stream_position.position;
+        if (_read_ahead && n) {
+            _read_ahead->on_skip(_stream_position.position - _sequential_read_start, _read_ahead_buffer_size);
+            _sequential_read_start = begin;
+        }
         _stream_position.position = begin;
 
         assert(end >= _stream_position.position);
@@ -640,6 +658,9 @@ class continuous_data_consumer : protected primitive_consumer {
     }
 
     future<> close() noexcept {
+        if (_read_ahead) {
+            _read_ahead->on_sequential_read(_stream_position.position - _sequential_read_start, _read_ahead_buffer_size);
+        }
         return _input.close();
     }
 };
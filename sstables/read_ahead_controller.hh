@@ -0,0 +1,61 @@
+/*
+ * Copyright (C) 2022-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstddef>
+
+namespace sstables {
+
+// Learns how many buffers a data file stream should read ahead of its
+// consumer, for one access pattern of one sstable.
+//
+// The stream's file_input_stream_history already adapts the size of the
+// buffers to how much of them is used. This adapts how many of them are in
+// flight: skipping forward before having consumed the read-ahead window means
+// the read-ahead was wasted and the window shrinks, while consuming several
+// windows in a row without skipping means the consumer would benefit from more
+// I/O in flight and the window grows.
+class read_ahead_controller {
+public:
+    static constexpr unsigned min_read_ahead = 1;
+    static constexpr unsigned max_read_ahead = 16;
+    static constexpr unsigned default_read_ahead = 4;
+private:
+    unsigned _read_ahead = default_read_ahead;
+public:
+    unsigned read_ahead() const noexcept {
+        return _read_ahead;
+    }
+
+    // Called when a stream skips forward, having consumed `consumed` bytes
+    // since it was started or since its previous skip.
+    void on_skip(uint64_t consumed, size_t buffer_size) noexcept {
+        if (consumed < window(buffer_size)) {
+            _read_ahead = std::max(_read_ahead / 2, min_read_ahead);
+        } else {
+            on_sequential_read(consumed, buffer_size);
+        }
+    }
+
+    // Called when a stream is done, having consumed `consumed` bytes since it
+    // was started or since its last skip.
+    void on_sequential_read(uint64_t consumed, size_t buffer_size) noexcept {
+        if (consumed >= 2 * window(buffer_size)) {
+            _read_ahead = std::min(_read_ahead * 2, max_read_ahead);
+        }
+    }
+private:
+    uint64_t window(size_t buffer_size) const noexcept {
+        return uint64_t(_read_ahead) * buffer_size;
+    }
+};
+
+}
@@ -16,6 +16,16 @@
 namespace sstables {
 
 // Immutable components that can be shared among shards.
+//
+// They are loaded once, by the shard which opens the sstable, and handed to
+// every other shard which needs the sstable by reference, through the
+// foreign_ptr of foreign_sstable_open_info. Shards never hold private copies,
+// so an sstable owned by several shards pays for its Summary and Filter once
+// per node. The memory stays charged to the loading shard until the last
+// reference goes away.
+//
+// A Filter loaded after the sstable was opened (see sstable::lazy_filter) is
+// not part of these components, as they can no longer be modified safely then.
 struct shareable_components {
     sstables::compression compression;
     utils::filter_ptr filter;
@@ -7,6 +7,7 @@
  */
 
 #include <seastar/core/coroutine.hh>
+#include <seastar/util/defer.hh>
 #include <boost/range/adaptor/map.hpp>
 #include "sstables/sstable_directory.hh"
 #include "sstables/sstables.hh"
@@ -37,7 +38,8 @@ sstable_directory::sstable_directory(fs::path sstable_dir,
         lack_of_toc_fatal throw_on_missing_toc,
         enable_dangerous_direct_import_of_cassandra_counters eddiocc,
         allow_loading_materialized_view allow_mv,
-        sstable_object_from_existing_fn sstable_from_existing)
+        sstable_object_from_existing_fn sstable_from_existing,
+        lazy_filter_loading lazy_filter)
     : _sstable_dir(std::move(sstable_dir))
     , _io_priority(std::move(io_prio))
     , _load_parallelism(load_parallelism)
@@ -46,6 +48,7 @@ sstable_directory::sstable_directory(fs::path sstable_dir,
     , _throw_on_missing_toc(throw_on_missing_toc)
     , _enable_dangerous_direct_import_of_cassandra_counters(eddiocc)
     , _allow_loading_materialized_view(allow_mv)
+    , _lazy_filter_loading(lazy_filter)
     , _sstable_object_from_existing_sstable(std::move(sstable_from_existing))
     , _unshared_remote_sstables(smp::count)
 {}
@@ -105,7 +108,7 @@ sstable_directory::process_descriptor(sstables::entry_descriptor desc, bool sort
     }
 
     auto sst = _sstable_object_from_existing_sstable(_sstable_dir, desc.generation, desc.version, desc.format);
-    return sst->load(_io_priority).then([this, sst] {
+    return sst->load(_io_priority, sstable::lazy_filter(bool(_lazy_filter_loading))).then([this, sst] {
         validate(sst);
         if (_need_mutate_level) {
             dirlog.trace("Mutating {} to level 0\n", sst->get_filename());
@@ -339,54 +342,150 @@ sstable_directory::collect_output_sstables_from_reshaping(std::vector<sstables::
     });
 }
 
+sstables::compaction_descriptor
+sstable_directory::get_reshaping_job(replica::table& table, sstables::reshape_mode mode,
+        const std::function<bool (const sstables::shared_sstable&)>& sstable_filter) const {
+    auto reshape_candidates = boost::copy_range<std::vector<shared_sstable>>(_unshared_local_sstables
+            | boost::adaptors::filtered([this, &sstable_filter] (const auto& sst) {
+        return !_sstables_being_reshaped.contains(sst) && sstable_filter(sst);
+    }));
+    return table.get_compaction_strategy().get_reshaping_job(std::move(reshape_candidates), table.schema(), _io_priority, mode);
+}
+
 future<uint64_t> sstable_directory::reshape(compaction_manager& cm, replica::table& table, sstables::compaction_sstable_creator_fn creator,
                                             sstables::reshape_mode mode, sstable_filter_func_t sstable_filter)
 {
-    return do_with(uint64_t(0), std::move(sstable_filter), [this, &cm, &table, creator = std::move(creator), mode] (uint64_t& reshaped_size, sstable_filter_func_t& filter) mutable {
-        return repeat([this, &cm, &table, creator = std::move(creator), &reshaped_size, mode, &filter] () mutable {
-            auto reshape_candidates = boost::copy_range<std::vector<shared_sstable>>(_unshared_local_sstables
-                    | boost::adaptors::filtered([this, &filter] (const auto& sst) {
-                return filter(sst);
-            }));
-            auto desc = table.get_compaction_strategy().get_reshaping_job(std::move(reshape_candidates), table.schema(), _io_priority, mode);
-            if (desc.sstables.empty()) {
-                return make_ready_future<stop_iteration>(stop_iteration::yes);
+    uint64_t reshaped_size = 0;
+    for (;;) {
+        auto desc = get_reshaping_job(table, mode, sstable_filter);
+        if (desc.sstables.empty()) {
+            if (!_lent_reshape_jobs) {
+                break;
             }
+            // Output of jobs run by other shards may need further reshaping.
+            co_await _lent_reshape_job_completed.wait();
+            continue;
+        }
 
-            if (!reshaped_size) {
-                dirlog.info("Table {}.{} with compaction strategy {} found SSTables that need reshape. Starting reshape process", table.schema()->ks_name(), table.schema()->cf_name(), table.get_compaction_strategy().name());
-            }
+        if (!reshaped_size) {
+            dirlog.info("Table {}.{} with compaction strategy {} found SSTables that need reshape. Starting reshape process", table.schema()->ks_name(), table.schema()->cf_name(), table.get_compaction_strategy().name());
+        }
 
-            std::vector<sstables::shared_sstable> sstlist;
-            for (auto& sst : desc.sstables) {
-                reshaped_size += sst->data_size();
-                sstlist.push_back(sst);
+        std::vector<sstables::shared_sstable> sstlist;
+        for (auto& sst : desc.sstables) {
+            reshaped_size += sst->data_size();
+            sstlist.push_back(sst);
+            _sstables_being_reshaped.insert(sst);
+        }
+        auto done_reshaping = defer([this, &sstlist] () noexcept {
+            for (auto& sst : sstlist) {
+                _sstables_being_reshaped.erase(sst);
             }
+        });
 
-            desc.creator = creator;
+        desc.creator = creator;
 
-            return cm.run_custom_job(table.as_table_state(), compaction_type::Reshape, "Reshape compaction", [this, &table, sstlist = std::move(sstlist), desc = std::move(desc)] (sstables::compaction_data& info) mutable {
-                return sstables::compact_sstables(std::move(desc), info, table.as_table_state()).then([this, sstlist = std::move(sstlist)] (sstables::compaction_result result) mutable {
-                    return remove_input_sstables_from_reshaping(std::move(sstlist)).then([this, new_sstables = std::move(result.new_sstables)] () mutable {
+        try {
+            co_await cm.run_custom_job(table.as_table_state(), compaction_type::Reshape, "Reshape compaction", [this, &table, &sstlist, desc = std::move(desc)] (sstables::compaction_data& info) mutable {
+                return sstables::compact_sstables(std::move(desc), info, table.as_table_state()).then([this, &sstlist] (sstables::compaction_result result) mutable {
+                    return remove_input_sstables_from_reshaping(sstlist).then([this, new_sstables = std::move(result.new_sstables)] () mutable {
                         return collect_output_sstables_from_reshaping(std::move(new_sstables));
                     });
                 });
-            }).then_wrapped([&table] (future<> f) {
-                try {
-                    f.get();
-                } catch (sstables::compaction_stopped_exception& e) {
-                    dirlog.info("Table {}.{} with compaction strategy {} had reshape successfully aborted.", table.schema()->ks_name(), table.schema()->cf_name(), table.get_compaction_strategy().name());
-                    return make_ready_future<stop_iteration>(stop_iteration::yes);
-                } catch (...) {
-                    dirlog.info("Reshape failed for Table {}.{} with compaction strategy {} due to {}", table.schema()->ks_name(), table.schema()->cf_name(), table.get_compaction_strategy().name(), std::current_exception());
-                    return make_ready_future<stop_iteration>(stop_iteration::yes);
-                }
-                return make_ready_future<stop_iteration>(stop_iteration::no);
             });
-        }).then([&reshaped_size] {
-            return make_ready_future<uint64_t>(reshaped_size);
+        } catch (sstables::compaction_stopped_exception& e) {
+            dirlog.info("Table {}.{} with compaction strategy {} had reshape successfully aborted.", table.schema()->ks_name(), table.schema()->cf_name(), table.get_compaction_strategy().name());
+            break;
+        } catch (...) {
+            dirlog.info("Reshape failed for Table {}.{} with compaction strategy {} due to {}", table.schema()->ks_name(), table.schema()->cf_name(), table.get_compaction_strategy().name(), std::current_exception());
+            break;
+        }
+    }
+    co_return reshaped_size;
+}
+
+future<sstable_directory::lent_reshape_job>
+sstable_directory::lend_reshape_job(replica::table& table, sstables::reshape_mode mode, const sstable_filter_func_t& sstable_filter) {
+    lent_reshape_job job;
+    auto desc = get_reshaping_job(table, mode, sstable_filter);
+    if (desc.sstables.empty()) {
+        co_return job;
+    }
+    // Mark the SSTables before yielding, so that neither this shard nor other
+    // helpers pick them again.
+    for (auto& sst : desc.sstables) {
+        _sstables_being_reshaped.insert(sst);
+    }
+    ++_lent_reshape_jobs;
+    job.level = desc.level;
+    job.max_sstable_bytes = desc.max_sstable_bytes;
+    try {
+        for (auto& sst : desc.sstables) {
+            job.sstables.push_back(co_await sst->get_open_info());
+        }
+    } catch (...) {
+        for (auto& sst : desc.sstables) {
+            _sstables_being_reshaped.erase(sst);
+        }
+        --_lent_reshape_jobs;
+        _lent_reshape_job_completed.broadcast();
+        throw;
+    }
+    dirlog.debug("Lending reshape of {} SSTables of {}.{}", job.sstables.size(), table.schema()->ks_name(), table.schema()->cf_name());
+    co_return job;
+}
+
+future<sstable_directory::sstable_info_vector>
+sstable_directory::run_lent_reshape_job(lent_reshape_job job, compaction_manager& cm, replica::table& table, sstables::compaction_sstable_creator_fn creator) {
+    std::vector<sstables::shared_sstable> sstlist;
+    for (auto& info : job.sstables) {
+        auto sst = _sstable_object_from_existing_sstable(_sstable_dir, info.generation, info.version, info.format);
+        co_await sst->load(std::move(info));
+        sstlist.push_back(std::move(sst));
+    }
+
+    sstables::compaction_descriptor desc(sstlist, _io_priority, job.level, job.max_sstable_bytes, utils::make_random_uuid(),
+            sstables::compaction_type_options::make_reshape(true));
+    desc.creator = std::move(creator);
+
+    std::vector<sstables::shared_sstable> new_sstables;
+    co_await cm.run_custom_job(table.as_table_state(), compaction_type::Reshape, "Reshape compaction", [&table, &new_sstables, desc = std::move(desc)] (sstables::compaction_data& info) mutable {
+        return sstables::compact_sstables(std::move(desc), info, table.as_table_state()).then([&new_sstables] (sstables::compaction_result result) {
+            new_sstables = std::move(result.new_sstables);
         });
     });
+
+    // The input SSTables are unlinked by the lending shard, once it switches to the output.
+    sstable_info_vector outputs;
+    for (auto& sst : new_sstables) {
+        outputs.push_back(co_await sst->get_open_info());
+    }
+    co_return outputs;
+}
+
+future<> sstable_directory::complete_lent_reshape_job(std::vector<generation_type> inputs, sstable_info_vector outputs, bool succeeded) {
+    auto done = defer([this] () noexcept {
+        --_lent_reshape_jobs;
+        _lent_reshape_job_completed.broadcast();
+    });
+
+    std::vector<sstables::shared_sstable> sstlist;
+    for (auto& sst : _unshared_local_sstables) {
+        if (std::find(inputs.begin(), inputs.end(), sst->generation()) != inputs.end()) {
+            _sstables_being_reshaped.erase(sst);
+            sstlist.push_back(sst);
+        }
+    }
+    if (!succeeded) {
+        co_return;
+    }
+
+    co_await remove_input_sstables_from_reshaping(std::move(sstlist));
+    for (auto& info : outputs) {
+        auto sst = _sstable_object_from_existing_sstable(_sstable_dir, info.generation, info.version, info.format);
+        co_await sst->load(std::move(info));
+        _unshared_local_sstables.push_back(std::move(sst));
+    }
 }
 
 future<>
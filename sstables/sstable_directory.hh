@@ -11,6 +11,7 @@
 #include <filesystem>
 #include <seastar/core/file.hh>
 #include <seastar/core/sharded.hh>
+#include <seastar/core/condition-variable.hh>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
@@ -38,6 +39,7 @@ class sstable_directory {
     using need_mutate_level = bool_class<class need_mutate_level_tag>;
     using enable_dangerous_direct_import_of_cassandra_counters = bool_class<class enable_dangerous_direct_import_of_cassandra_counters_tag>;
     using allow_loading_materialized_view = bool_class<class allow_loading_materialized_view_tag>;
+    using lazy_filter_loading = bool_class<class lazy_filter_loading_tag>;
 
     using sstable_object_from_existing_fn =
         noncopyable_function<sstables::shared_sstable(std::filesystem::path,
@@ -82,6 +84,8 @@ class sstable_directory {
     lack_of_toc_fatal _throw_on_missing_toc;
     enable_dangerous_direct_import_of_cassandra_counters _enable_dangerous_direct_import_of_cassandra_counters;
     allow_loading_materialized_view _allow_loading_materialized_view;
+    // Whether to defer reading the Filter component, see sstable::lazy_filter.
+    lazy_filter_loading _lazy_filter_loading;
 
     // How to create an SSTable object from an existing SSTable file (respecting generation, etc)
     sstable_object_from_existing_fn _sstable_object_from_existing_sstable;
@@ -115,11 +119,20 @@ class sstable_directory {
     future<> remove_input_sstables_from_reshaping(std::vector<sstables::shared_sstable> sstlist);
     future<> collect_output_sstables_from_reshaping(std::vector<sstables::shared_sstable> reshaped_sstables);
 
+    sstables::compaction_descriptor get_reshaping_job(replica::table& table, sstables::reshape_mode mode,
+            const std::function<bool (const sstables::shared_sstable&)>& sstable_filter) const;
+
     template <typename Container, typename Func>
     future<> parallel_for_each_restricted(Container&& C, Func&& func);
     future<> load_foreign_sstables(sstable_info_vector info_vec);
 
     std::vector<sstables::shared_sstable> _unsorted_sstables;
+
+    // SSTables picked by a reshape job in progress, run either by this shard or, for jobs
+    // lent with lend_reshape_job(), by another one.
+    std::unordered_set<sstables::shared_sstable> _sstables_being_reshaped;
+    unsigned _lent_reshape_jobs = 0;
+    condition_variable _lent_reshape_job_completed;
 public:
     sstable_directory(std::filesystem::path sstable_dir,
             ::io_priority_class io_prio,
@@ -129,7 +142,8 @@ class sstable_directory {
             lack_of_toc_fatal fatal_nontoc,
             enable_dangerous_direct_import_of_cassandra_counters eddiocc,
             allow_loading_materialized_view,
-            sstable_object_from_existing_fn sstable_from_existing);
+            sstable_object_from_existing_fn sstable_from_existing,
+            lazy_filter_loading lazy_filter = lazy_filter_loading::no);
 
     std::vector<sstables::shared_sstable>& get_unsorted_sstables() {
         return _unsorted_sstables;
@@ -186,11 +200,37 @@ class sstable_directory {
     }
 
     // reshapes a collection of SSTables, and returns the total amount of bytes reshaped.
+    //
+    // Jobs lent to other shards with lend_reshape_job() are waited for before returning,
+    // as their output may need further reshaping.
     future<uint64_t> reshape(compaction_manager& cm, replica::table& table,
                      sstables::compaction_sstable_creator_fn creator,
                      sstables::reshape_mode mode,
                      sstable_filter_func_t sstable_filter = default_sstable_filter());
 
+    // A reshape job picked among the SSTables of one shard, to be run by another
+    // one, so that a shard with a large reshape backlog can use the CPU of shards
+    // which are done with their own.
+    struct lent_reshape_job {
+        sstable_info_vector sstables;
+        int level = sstables::compaction_descriptor::default_level;
+        uint64_t max_sstable_bytes = sstables::compaction_descriptor::default_max_sstable_bytes;
+    };
+
+    // Picks a reshape job for another shard to run. The job has no SSTables if
+    // there is nothing left to reshape. Until complete_lent_reshape_job() is called,
+    // the SSTables of the job are skipped by this shard's own reshape.
+    future<lent_reshape_job> lend_reshape_job(replica::table& table, sstables::reshape_mode mode, const sstable_filter_func_t& sstable_filter);
+
+    // Runs, on this shard, a job lent by another one and returns the output SSTables,
+    // which belong to the lending shard.
+    future<sstable_info_vector> run_lent_reshape_job(lent_reshape_job job, compaction_manager& cm, replica::table& table,
+                     sstables::compaction_sstable_creator_fn creator);
+
+    // Replaces the input SSTables of a job lent by this shard with its output. If the job
+    // failed, the input SSTables are just made available to this shard's reshape again.
+    future<> complete_lent_reshape_job(std::vector<generation_type> inputs, sstable_info_vector outputs, bool succeeded);
+
     // Store a phased operation. Usually used to keep an object alive while the directory is being
     // processed. One example is preventing table drops concurrent to the processing of this
     // directory.
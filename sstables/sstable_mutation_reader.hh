@@ -119,9 +119,13 @@ inline std::unique_ptr<DataConsumeRowsContext> data_consume_rows(const schema& s
     // This potentially enables read-ahead beyond end, until last_end, which
     // can be beneficial if the user wants to fast_forward_to() on the
     // returned context, and may make small skips.
+    auto& read_ahead = sst->data_read_ahead(sst->_partition_range_read_ahead, consumer.io_priority());
     auto input = sst->data_stream(toread.start, last_end - toread.start, consumer.io_priority(),
-            consumer.permit(), consumer.trace_state(), sst->_partition_range_history);
-    return std::make_unique<DataConsumeRowsContext>(s, std::move(sst), consumer, std::move(input), toread.start, toread.end - toread.start);
+            consumer.permit(), consumer.trace_state(), sst->_partition_range_history, sstable::raw_stream::no, &read_ahead);
+    auto buffer_size = sst->sstable_buffer_size;
+    auto context = std::make_unique<DataConsumeRowsContext>(s, std::move(sst), consumer, std::move(input), toread.start, toread.end - toread.start);
+    context->set_read_ahead_controller(read_ahead, buffer_size);
+    return context;
 }
 
 template <typename DataConsumeRowsContext>
@@ -153,9 +157,13 @@ inline reversed_context<DataConsumeRowsContext> data_consume_reversed_partition(
 
 template <typename DataConsumeRowsContext>
 inline std::unique_ptr<DataConsumeRowsContext> data_consume_single_partition(const schema& s, shared_sstable sst, typename DataConsumeRowsContext::consumer& consumer, sstable::disk_read_range toread) {
+    auto& read_ahead = sst->data_read_ahead(sst->_single_partition_read_ahead, consumer.io_priority());
     auto input = sst->data_stream(toread.start, toread.end - toread.start, consumer.io_priority(),
-            consumer.permit(), consumer.trace_state(), sst->_single_partition_history);
-    return std::make_unique<DataConsumeRowsContext>(s, std::move(sst), consumer, std::move(input), toread.start, toread.end - toread.start);
+            consumer.permit(), consumer.trace_state(), sst->_single_partition_history, sstable::raw_stream::no, &read_ahead);
+    auto buffer_size = sst->sstable_buffer_size;
+    auto context = std::make_unique<DataConsumeRowsContext>(s, std::move(sst), consumer, std::move(input), toread.start, toread.end - toread.start);
+    context->set_read_ahead_controller(read_ahead, buffer_size);
+    return context;
 }
 
 // Like data_consume_rows() with bounds, but iterates over whole range
@@ -7,11 +7,14 @@
  */
 
 #include <seastar/util/defer.hh>
+#include <seastar/core/coroutine.hh>
+#include <seastar/coroutine/parallel_for_each.hh>
 
 #include <boost/icl/interval_map.hpp>
 #include <boost/range/adaptor/map.hpp>
 #include <boost/range/algorithm/remove_if.hpp>
 #include <boost/range/algorithm/sort.hpp>
+#include <boost/range/irange.hpp>
 
 #include "compatible_ring_position.hh"
 #include "compaction/compaction_strategy_impl.hh"
@@ -764,6 +767,113 @@ sstable_set_impl::select_sstable_runs(const std::vector<shared_sstable>& sstable
     throw_with_backtrace<std::bad_function_call>();
 }
 
+// Reads a single partition from several sstables, skipping the sstables whose content
+// in the partition is entirely shadowed by a partition tombstone stored in another
+// sstable, like the rows of a deleted queue partition.
+//
+// The readers are peeked at concurrently, which reads the partition tombstones.
+// Shadowed sstables are then dropped before their data is merged and compacted away,
+// so they cost a single buffer instead of the whole partition.
+class partition_tombstone_filtering_reader : public flat_mutation_reader_v2::impl {
+public:
+    struct sstable_reader {
+        // Disengaged for readers which must not be dropped.
+        shared_sstable sst;
+        flat_mutation_reader_v2 reader;
+    };
+private:
+    std::vector<sstable_reader> _readers;
+    replica::cf_stats& _stats;
+    streamed_mutation::forwarding _fwd;
+    mutation_reader::forwarding _fwd_mr;
+    flat_mutation_reader_v2_opt _reader;
+
+    future<> init() {
+        std::vector<tombstone> tombstones(_readers.size());
+        co_await coroutine::parallel_for_each(boost::irange(size_t(0), _readers.size()), [&] (size_t i) -> future<> {
+            auto* mf = co_await _readers[i].reader.peek();
+            if (mf && mf->is_partition_start()) {
+                tombstones[i] = mf->as_partition_start().partition_tombstone();
+            }
+        });
+
+        auto newest = std::max_element(tombstones.begin(), tombstones.end()) - tombstones.begin();
+        const auto t = tombstones[newest];
+
+        std::vector<flat_mutation_reader_v2> kept;
+        std::vector<flat_mutation_reader_v2> dropped;
+        kept.reserve(_readers.size());
+        for (size_t i = 0; i < _readers.size(); ++i) {
+            auto& r = _readers[i];
+            // A partition tombstone shadows the data which is not newer than it.
+            if (t && r.sst && size_t(newest) != i && r.sst->get_stats_metadata().max_timestamp <= t.timestamp) {
+                dropped.push_back(std::move(r.reader));
+            } else {
+                kept.push_back(std::move(r.reader));
+            }
+        }
+        _readers.clear();
+        _stats.sstables_skipped_by_partition_tombstone += dropped.size();
+        _reader = make_combined_reader(_schema, _permit, std::move(kept), _fwd, _fwd_mr);
+        co_await coroutine::parallel_for_each(dropped, [] (flat_mutation_reader_v2& rd) {
+            return rd.close();
+        });
+    }
+public:
+    partition_tombstone_filtering_reader(schema_ptr s, reader_permit permit, std::vector<sstable_reader> readers, replica::cf_stats& stats,
+            streamed_mutation::forwarding fwd, mutation_reader::forwarding fwd_mr)
+        : impl(std::move(s), std::move(permit))
+        , _readers(std::move(readers))
+        , _stats(stats)
+        , _fwd(fwd)
+        , _fwd_mr(fwd_mr)
+    { }
+
+    virtual future<> fill_buffer() override {
+        if (!_reader) {
+            co_await init();
+        }
+        co_await _reader->fill_buffer();
+        _end_of_stream = _reader->is_end_of_stream();
+        _reader->move_buffer_content_to(*this);
+    }
+    virtual future<> next_partition() override {
+        clear_buffer_to_next_partition();
+        if (!is_buffer_empty()) {
+            co_return;
+        }
+        _end_of_stream = false;
+        if (!_reader) {
+            co_await init();
+        }
+        co_await _reader->next_partition();
+    }
+    virtual future<> fast_forward_to(const dht::partition_range& pr) override {
+        clear_buffer();
+        _end_of_stream = false;
+        if (!_reader) {
+            co_await init();
+        }
+        co_await _reader->fast_forward_to(pr);
+    }
+    virtual future<> fast_forward_to(position_range pr) override {
+        forward_buffer_to(pr.start());
+        _end_of_stream = false;
+        if (!_reader) {
+            co_await init();
+        }
+        co_await _reader->fast_forward_to(std::move(pr));
+    }
+    virtual future<> close() noexcept override {
+        if (_reader) {
+            co_await _reader->close();
+        }
+        co_await coroutine::parallel_for_each(_readers, [] (sstable_reader& r) {
+            return r.reader.close();
+        });
+    }
+};
+
 flat_mutation_reader_v2
 sstable_set_impl::create_single_key_sstable_reader(
         replica::column_family* cf,
@@ -783,11 +893,11 @@ sstable_set_impl::create_single_key_sstable_reader(
     if (!num_sstables) {
         return make_empty_flat_reader_v2(schema, permit);
     }
-    auto readers = boost::copy_range<std::vector<flat_mutation_reader_v2>>(
-        filter_sstable_for_reader_by_ck(std::move(selected_sstables), *cf, schema, slice)
+    auto sstables = filter_sstable_for_reader_by_ck(std::move(selected_sstables), *cf, schema, slice);
+    auto readers = boost::copy_range<std::vector<partition_tombstone_filtering_reader::sstable_reader>>(sstables
         | boost::adaptors::transformed([&] (const shared_sstable& sstable) {
             tracing::trace(trace_state, "Reading key {} from sstable {}", pos, seastar::value_of([&sstable] { return sstable->get_filename(); }));
-            return sstable->make_reader(schema, permit, pr, slice, pc, trace_state, fwd);
+            return partition_tombstone_filtering_reader::sstable_reader{sstable, sstable->make_reader(schema, permit, pr, slice, pc, trace_state, fwd)};
         })
     );
 
@@ -801,10 +911,18 @@ sstable_set_impl::create_single_key_sstable_reader(
     // all sstables actually containing the partition were filtered.
     auto num_readers = readers.size();
     if (num_readers != num_sstables) {
-        readers.push_back(make_flat_mutation_reader_from_mutations_v2(schema, permit, {mutation(schema, *pos.key())}, slice, fwd));
+        readers.push_back({nullptr, make_flat_mutation_reader_from_mutations_v2(schema, permit, {mutation(schema, *pos.key())}, slice, fwd)});
     }
     sstable_histogram.add(num_readers);
-    return make_combined_reader(schema, std::move(permit), std::move(readers), fwd, fwd_mr);
+
+    // Skipping sstables shadowed by a partition tombstone only pays off when there
+    // is more than one sstable and some of them may have partition tombstones.
+    if (num_readers > 1 && std::any_of(sstables.begin(), sstables.end(), std::mem_fn(&sstable::may_have_partition_tombstones))) {
+        return make_flat_mutation_reader_v2<partition_tombstone_filtering_reader>(std::move(schema), std::move(permit), std::move(readers),
+                *cf->cf_stats(), fwd, fwd_mr);
+    }
+    return make_combined_reader(schema, std::move(permit), boost::copy_range<std::vector<flat_mutation_reader_v2>>(readers
+            | boost::adaptors::transformed([] (partition_tombstone_filtering_reader::sstable_reader& r) { return std::move(r.reader); })), fwd, fwd_mr);
 }
 
 flat_mutation_reader_v2
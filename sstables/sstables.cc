@@ -77,6 +77,7 @@
 #include "tombstone_gc.hh"
 #include "reader_concurrency_semaphore.hh"
 #include "readers/reversing_v2.hh"
+#include "service/priority_manager.hh"
 #include "readers/forwardable_v2.hh"
 
 #include "release.hh"
@@ -1346,10 +1347,9 @@ future<> sstable::drop_caches() {
     });
 }
 
-future<> sstable::read_filter(const io_priority_class& pc) {
+future<utils::filter_ptr> sstable::read_filter_component(const io_priority_class& pc) {
     if (!has_component(component_type::Filter)) {
-        _components->filter = std::make_unique<utils::filter::always_present_filter>();
-        return make_ready_future<>();
+        return make_ready_future<utils::filter_ptr>(std::make_unique<utils::filter::always_present_filter>());
     }
 
     return seastar::async([this, &pc] () mutable {
@@ -1360,10 +1360,40 @@ future<> sstable::read_filter(const io_priority_class& pc) {
         utils::filter_format format = (_version >= sstable_version_types::mc)
                                       ? utils::filter_format::m_format
                                       : utils::filter_format::k_l_format;
-        _components->filter = utils::filter::create_filter(filter.hashes, std::move(bs), format);
+        return utils::filter::create_filter(filter.hashes, std::move(bs), format);
+    });
+}
+
+future<> sstable::read_filter(const io_priority_class& pc) {
+    return read_filter_component(pc).then([this] (utils::filter_ptr filter) {
+        _components->filter = std::move(filter);
     });
 }
 
+future<> sstable::load_filter(const io_priority_class& pc) {
+    if (filter_loaded()) {
+        return make_ready_future<>();
+    }
+    if (!_lazy_filter_loading) {
+        _lazy_filter_loading = read_filter_component(pc).then([this] (utils::filter_ptr filter) {
+            _lazy_filter = std::move(filter);
+        });
+    }
+    return _lazy_filter_loading->get_future().handle_exception([this] (std::exception_ptr ep) {
+        // Let the next call retry.
+        _lazy_filter_loading.reset();
+        return make_exception_future<>(std::move(ep));
+    });
+}
+
+utils::i_filter& sstable::get_filter() const noexcept {
+    static thread_local utils::filter::always_present_filter not_loaded_filter;
+    if (_components->filter) {
+        return *_components->filter;
+    }
+    return _lazy_filter ? *_lazy_filter : not_loaded_filter;
+}
+
 void sstable::write_filter(const io_priority_class& pc) {
     if (!has_component(component_type::Filter)) {
         return;
@@ -1378,17 +1408,17 @@ void sstable::write_filter(const io_priority_class& pc) {
 
 // This interface is only used during tests, snapshot loading and early initialization.
 // No need to set tunable priorities for it.
-future<> sstable::load(const io_priority_class& pc) noexcept {
-    return read_toc().then([this, &pc] {
+future<> sstable::load(const io_priority_class& pc, lazy_filter lazy) noexcept {
+    return read_toc().then([this, &pc, lazy] {
         // read scylla-meta after toc. Might need it to parse
         // rest (hint extensions)
-        return read_scylla_metadata(pc).then([this, &pc] {
+        return read_scylla_metadata(pc).then([this, &pc, lazy] {
             // Read statistics ahead of others - if summary is missing
             // we'll attempt to re-generate it and we need statistics for that
-            return read_statistics(pc).then([this, &pc] {
+            return read_statistics(pc).then([this, &pc, lazy] {
                 return seastar::when_all_succeed(
                         read_compression(pc),
-                        read_filter(pc),
+                        lazy ? make_ready_future<>() : read_filter(pc),
                         read_summary(pc)).then_unpack([this] {
                             validate_min_max_metadata();
                             validate_max_local_deletion_time();
@@ -2291,12 +2321,17 @@ component_type sstable::component_from_sstring(version_types v, sstring &s) {
     }
 }
 
+read_ahead_controller& sstable::data_read_ahead(read_ahead_controller& query_read_ahead, const io_priority_class& pc) noexcept {
+    return pc.id() == service::get_local_sstable_query_read_priority().id() ? query_read_ahead : _maintenance_read_ahead;
+}
+
 input_stream<char> sstable::data_stream(uint64_t pos, size_t len, const io_priority_class& pc,
-        reader_permit permit, tracing::trace_state_ptr trace_state, lw_shared_ptr<file_input_stream_history> history, raw_stream raw) {
+        reader_permit permit, tracing::trace_state_ptr trace_state, lw_shared_ptr<file_input_stream_history> history, raw_stream raw,
+        const read_ahead_controller* read_ahead) {
     file_input_stream_options options;
     options.buffer_size = sstable_buffer_size;
     options.io_priority_class = pc;
-    options.read_ahead = 4;
+    options.read_ahead = read_ahead ? read_ahead->read_ahead() : read_ahead_controller::default_read_ahead;
     options.dynamic_adjustments = std::move(history);
 
     file f = make_tracked_file(_data_file, std::move(permit));
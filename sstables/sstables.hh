@@ -17,6 +17,7 @@
 #include <seastar/core/sstring.hh>
 #include <seastar/core/enum.hh>
 #include <seastar/core/shared_ptr.hh>
+#include <seastar/core/shared_future.hh>
 #include <seastar/core/distributed.hh>
 #include <unordered_set>
 #include <unordered_map>
@@ -36,6 +37,7 @@
 #include "compound_compat.hh"
 #include "utils/disk-error-handler.hh"
 #include "sstables/progress_monitor.hh"
+#include "sstables/read_ahead_controller.hh"
 #include "db/commitlog/replay_position.hh"
 #include "component_type.hh"
 #include "sstable_version.hh"
@@ -184,12 +186,23 @@ class sstable : public enable_lw_shared_from_this<sstable> {
     static sstring filename(const sstring& dir, const sstring& ks, const sstring& cf, version_types version, generation_type generation,
                             format_types format, sstring component);
 
+    // With lazy_filter::yes, load() does not read the Filter component, which
+    // is typically the largest one kept in memory. Until load_filter() is called,
+    // filter_has_key() reports every key as present, which is correct but makes
+    // reads and compaction consult this sstable for keys it does not hold.
+    using lazy_filter = bool_class<class lazy_filter_tag>;
+
     // load sstable using components shared by a shard
     future<> load(foreign_sstable_open_info info) noexcept;
     // load all components from disk
     // this variant will be useful for testing purposes and also when loading
     // a new sstable from scratch for sharing its components.
-    future<> load(const io_priority_class& pc = default_priority_class()) noexcept;
+    future<> load(const io_priority_class& pc = default_priority_class(), lazy_filter lazy = lazy_filter::no) noexcept;
+    // Reads the Filter component if load() skipped it. Concurrent calls share a single read.
+    future<> load_filter(const io_priority_class& pc = default_priority_class());
+    bool filter_loaded() const noexcept {
+        return _components->filter || _lazy_filter;
+    }
     future<> open_data() noexcept;
     future<> update_info_for_opened_data();
 
@@ -322,7 +335,7 @@ class sstable : public enable_lw_shared_from_this<sstable> {
     }
 
     uint64_t filter_memory_size() const {
-        return _components->filter->memory_size();
+        return filter_loaded() ? get_filter().memory_size() : 0;
     }
 
     version_types get_version() const {
@@ -508,6 +521,9 @@ class sstable : public enable_lw_shared_from_this<sstable> {
 
     lw_shared_ptr<file_input_stream_history> _single_partition_history = make_lw_shared<file_input_stream_history>();
     lw_shared_ptr<file_input_stream_history> _partition_range_history = make_lw_shared<file_input_stream_history>();
+    read_ahead_controller _single_partition_read_ahead;
+    read_ahead_controller _partition_range_read_ahead;
+    read_ahead_controller _maintenance_read_ahead;
     lw_shared_ptr<file_input_stream_history> _index_history = make_lw_shared<file_input_stream_history>();
 
     schema_ptr _schema;
@@ -519,6 +535,10 @@ class sstable : public enable_lw_shared_from_this<sstable> {
     format_types _format;
 
     filter_tracker _filter_tracker;
+    // Filter loaded after the sstable was opened with lazy_filter::yes. It is kept
+    // here rather than in _components, which may be shared with other shards.
+    utils::filter_ptr _lazy_filter;
+    std::optional<shared_future<>> _lazy_filter_loading;
     std::unique_ptr<partition_index_cache> _index_cache;
 
     enum class mark_for_deletion {
@@ -585,6 +605,7 @@ class sstable : public enable_lw_shared_from_this<sstable> {
     void write_scylla_metadata(const io_priority_class& pc, shard_id shard, sstable_enabled_features features, run_identifier identifier,
             std::optional<scylla_metadata::large_data_stats> ld_stats, sstring origin);
 
+    future<utils::filter_ptr> read_filter_component(const io_priority_class& pc);
     future<> read_filter(const io_priority_class& pc);
 
     void write_filter(const io_priority_class& pc);
@@ -637,8 +658,11 @@ class sstable : public enable_lw_shared_from_this<sstable> {
     // When created with `raw_stream::yes`, the sstable data file will be
     // streamed as-is, without decompressing (if compressed).
     using raw_stream = bool_class<class raw_stream_tag>;
+    // If read_ahead is given, it chooses how many buffers are read ahead,
+    // otherwise read_ahead_controller::default_read_ahead are.
     input_stream<char> data_stream(uint64_t pos, size_t len, const io_priority_class& pc,
-            reader_permit permit, tracing::trace_state_ptr trace_state, lw_shared_ptr<file_input_stream_history> history, raw_stream raw = raw_stream::no);
+            reader_permit permit, tracing::trace_state_ptr trace_state, lw_shared_ptr<file_input_stream_history> history, raw_stream raw = raw_stream::no,
+            const read_ahead_controller* read_ahead = nullptr);
 
     // Read exactly the specific byte range from the data file (after
     // uncompression, if the file is compressed). This can be used to read
@@ -651,6 +675,13 @@ class sstable : public enable_lw_shared_from_this<sstable> {
 private:
     future<summary_entry&> read_summary_entry(size_t i);
 
+    // Chooses the read-ahead controller of a data file read. User reads use
+    // the one of their access pattern, given as query_read_ahead. Compaction,
+    // streaming and repair read the file sequentially and share a separate
+    // controller, so that user scans which skip a lot don't shrink their
+    // read-ahead.
+    read_ahead_controller& data_read_ahead(read_ahead_controller& query_read_ahead, const io_priority_class& pc) noexcept;
+
     // FIXME: pending on Bloom filter implementation
     bool filter_has_key(const schema& s, const dht::decorated_key& dk) { return filter_has_key(key::from_partition_key(s, dk._key)); }
 
@@ -721,8 +752,10 @@ class sstable : public enable_lw_shared_from_this<sstable> {
         return (_version >= sstable_version_types::mc) || has_scylla_component();
     }
 
+    utils::i_filter& get_filter() const noexcept;
+
     bool filter_has_key(const key& key) const {
-        return _components->filter->is_present(bytes_view(key));
+        return get_filter().is_present(bytes_view(key));
     }
 
     /*!
@@ -734,7 +767,7 @@ class sstable : public enable_lw_shared_from_this<sstable> {
     future<bool> has_partition_key(const utils::hashed_key& hk, const dht::decorated_key& dk);
 
     bool filter_has_key(utils::hashed_key key) const {
-        return _components->filter->is_present(key);
+        return get_filter().is_present(key);
     }
 
     bool filter_has_key(const schema& s, partition_key_view key) const {
@@ -34,4 +34,14 @@ BOOST_AUTO_TEST_CASE(test_caching_options) {
         sstring in_str = "{\"keys\": \"NONE, }";
         BOOST_REQUIRE_THROW(caching_options::from_sstring(in_str), std::exception);
     }
+    {
+        string_map in_map = { {"compression", "LZ4"}, {"keys", "ALL"}, {"rows_per_partition", "ALL"}};
+        caching_options co = caching_options::from_map(in_map);
+        BOOST_REQUIRE(co.compressed());
+        BOOST_REQUIRE(in_map == co.to_map());
+    }
+    {
+        string_map in_map = { {"compression", "ZSTD"}, {"keys", "ALL"}, {"rows_per_partition", "ALL"}};
+        BOOST_REQUIRE_THROW(caching_options::from_map(in_map), std::exception);
+    }
 }
@@ -185,3 +185,67 @@ SEASTAR_THREAD_TEST_CASE(test_skip_at_end) {
         consumer.run();
     }
 }
+
+// Consumes everything in its range.
+class sequential_consumer final : public data_consumer::continuous_data_consumer<sequential_consumer> {
+public:
+    sequential_consumer(reader_permit permit, input_stream<char> input, size_t maxlen)
+        : continuous_data_consumer(std::move(permit), std::move(input), 0, maxlen)
+    { }
+
+    bool non_consuming() { return false; }
+
+    void verify_end_state() {}
+
+    data_consumer::processing_result process_state(temporary_buffer<char>& data) {
+        data.trim(0);
+        return data_consumer::proceed::yes;
+    }
+
+    void run() {
+        consume_input().get();
+    }
+};
+
+SEASTAR_THREAD_TEST_CASE(test_read_ahead_adapts_to_skips) {
+    using sstables::read_ahead_controller;
+    tests::reader_concurrency_semaphore_wrapper semaphore;
+    constexpr size_t buffer_size = 1024;
+    constexpr size_t data_size = 256 * buffer_size;
+    auto make_stream = [] {
+        return make_buffer_input_stream(temporary_buffer<char>(data_size), [] { return buffer_size; });
+    };
+    read_ahead_controller read_ahead;
+
+    // Point reads skip after a fraction of a buffer, so the read-ahead window shrinks to the minimum.
+    {
+        sequential_consumer consumer(semaphore.make_permit(), make_stream(), buffer_size / 2);
+        consumer.set_read_ahead_controller(read_ahead, buffer_size);
+        for (uint64_t pos = 0; pos + 8 * buffer_size < data_size; pos += 8 * buffer_size) {
+            consumer.run();
+            BOOST_REQUIRE_EQUAL(consumer.position(), pos + buffer_size / 2);
+            consumer.fast_forward_to(pos + 8 * buffer_size, pos + 8 * buffer_size + buffer_size / 2).get();
+        }
+        consumer.close().get();
+    }
+    BOOST_REQUIRE_EQUAL(read_ahead.read_ahead(), read_ahead_controller::min_read_ahead);
+
+    // Consuming two windows before skipping grows it.
+    {
+        sequential_consumer consumer(semaphore.make_permit(), make_stream(), 2 * buffer_size);
+        consumer.set_read_ahead_controller(read_ahead, buffer_size);
+        consumer.run();
+        consumer.fast_forward_to(4 * buffer_size, 4 * buffer_size).get();
+        BOOST_REQUIRE_EQUAL(read_ahead.read_ahead(), 2 * read_ahead_controller::min_read_ahead);
+        consumer.close().get();
+    }
+
+    // Scans which don't skip grow it up to the maximum.
+    for (int i = 0; i < 10; ++i) {
+        sequential_consumer consumer(semaphore.make_permit(), make_stream(), data_size);
+        consumer.set_read_ahead_controller(read_ahead, buffer_size);
+        consumer.run();
+        consumer.close().get();
+    }
+    BOOST_REQUIRE_EQUAL(read_ahead.read_ahead(), read_ahead_controller::max_read_ahead);
+}
@@ -4539,6 +4539,28 @@ SEASTAR_TEST_CASE(test_like_parameter_marker) {
     });
 }
 
+SEASTAR_TEST_CASE(test_lwt_paxos_state) {
+    return do_with_cql_env_thread([] (cql_test_env& e) {
+        cquery_nofail(e, "CREATE TABLE t (pk int PRIMARY KEY, v int)");
+        cquery_nofail(e, "INSERT INTO t (pk, v) VALUES (1, 1)");
+
+        const sstring query("UPDATE t SET v = ? WHERE pk = ? IF v = ?");
+        prepared_on_shard(e, query, {I(2), I(1), I(1)}, {{B(true), I(1)}});
+
+        // The round was learned, so only the promise and the decision remain.
+        auto msg = cquery_nofail(e, "SELECT proposal, proposal_ballot FROM system.paxos");
+        assert_that(msg).is_rows().with_rows({{std::nullopt, std::nullopt}});
+        msg = cquery_nofail(e, "SELECT promise, most_recent_commit_at FROM system.paxos");
+        assert_that(msg).is_rows().with_size(1);
+        auto row = dynamic_pointer_cast<cql_transport::messages::result_message::rows>(msg)->rs().result_set().rows().front();
+        BOOST_REQUIRE(row[0]);
+        BOOST_REQUIRE_EQUAL(row[0], row[1]);
+
+        prepared_on_shard(e, query, {I(3), I(1), I(2)}, {{B(true), I(2)}});
+        assert_that(cquery_nofail(e, "SELECT v FROM t WHERE pk = 1")).is_rows().with_rows({{I(3)}});
+    });
+}
+
 SEASTAR_TEST_CASE(test_list_parameter_marker) {
     return do_with_cql_env_thread([] (cql_test_env& e) {
         cquery_nofail(e, "CREATE TABLE t (k int PRIMARY KEY, v list<int>)");
@@ -4778,6 +4800,28 @@ static future<> test_clustering_filtering_with_compaction_strategy(const std::st
     }, cql_test_config(db_config));
 }
 
+SEASTAR_TEST_CASE(test_skip_sstables_shadowed_by_partition_tombstone) {
+    return do_with_cql_env_thread([] (cql_test_env& e) {
+        cquery_nofail(e, "CREATE TABLE cf(pk int, ck int, v int, PRIMARY KEY(pk, ck))");
+        for (int ck = 0; ck < 10; ++ck) {
+            cquery_nofail(e, format("INSERT INTO cf(pk, ck, v) VALUES (0, {}, {}) USING TIMESTAMP 10", ck, ck));
+        }
+        e.db().invoke_on_all([] (replica::database& db) { return db.flush_all_memtables(); }).get();
+        cquery_nofail(e, "DELETE FROM cf USING TIMESTAMP 20 WHERE pk = 0");
+        cquery_nofail(e, "INSERT INTO cf(pk, ck, v) VALUES (0, 5, 50) USING TIMESTAMP 30");
+        e.db().invoke_on_all([] (replica::database& db) { return db.flush_all_memtables(); }).get();
+
+        auto skipped = [&e] {
+            return e.db().map_reduce0([] (replica::database& db) {
+                return db.find_column_family("ks", "cf").cf_stats()->sstables_skipped_by_partition_tombstone;
+            }, int64_t(0), std::plus<int64_t>()).get0();
+        };
+        const auto skipped_before = skipped();
+        require_rows(e, "SELECT ck, v FROM cf WHERE pk = 0 BYPASS CACHE", {{I(5), I(50)}});
+        BOOST_REQUIRE_EQUAL(skipped() - skipped_before, 1);
+    });
+}
+
 SEASTAR_TEST_CASE(test_clustering_filtering) {
     static std::array<std::string_view, 2> test_compaction_strategies = {
         "SizeTieredCompactionStrategy",
@@ -4852,6 +4896,24 @@ SEASTAR_TEST_CASE(test_counter_column_added_into_non_counter_table) {
     });
 }
 
+SEASTAR_TEST_CASE(test_concurrent_counter_updates) {
+    return do_with_cql_env_thread([] (cql_test_env& e) {
+        cquery_nofail(e, "CREATE TABLE t (pk int, ck int, c1 counter, c2 counter, PRIMARY KEY(pk, ck))");
+
+        // Concurrent updates of a partition are coalesced, make sure none of them is lost.
+        const int updates = 100;
+        parallel_for_each(boost::irange(0, updates), [&e] (int i) {
+            return e.execute_cql(format("UPDATE t SET c1 = c1 + 1, c2 = c2 + {} WHERE pk = 0 AND ck = {}", i, i % 2)).discard_result();
+        }).get();
+
+        auto msg = cquery_nofail(e, "SELECT ck, c1, c2 FROM t WHERE pk = 0");
+        assert_that(msg).is_rows().with_rows({
+            {int32_type->decompose(0), long_type->decompose(int64_t(updates / 2)), long_type->decompose(int64_t(2450))},
+            {int32_type->decompose(1), long_type->decompose(int64_t(updates / 2)), long_type->decompose(int64_t(2500))},
+        });
+    });
+}
+
 SEASTAR_THREAD_TEST_CASE(test_invalid_using_timestamps) {
     do_with_cql_env_thread([] (cql_test_env& e) {
         auto now_nano = std::chrono::duration_cast<std::chrono::nanoseconds>(db_clock::now().time_since_epoch()).count();
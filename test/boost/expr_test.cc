@@ -1,4 +1,5 @@
 #include "cql3/column_identifier.hh"
+#include "cql3/column_specification.hh"
 #include "cql3/util.hh"
 #include "seastar/core/shared_ptr.hh"
 #include "types.hh"
@@ -376,3 +377,28 @@ BOOST_AUTO_TEST_CASE(boolean_factors_test) {
         )
     );
 }
+
+BOOST_AUTO_TEST_CASE(fold_constants_test) {
+    auto receiver = make_lw_shared<column_specification>("ks", "tab", ::make_shared<column_identifier>("r", true), int32_type);
+    bind_variable bv{.bind_index = 0, .receiver = receiver};
+    query_options options({raw_value::make_value(int32_type->decompose(123))});
+
+    // Bind variables are replaced by their values, columns are kept.
+    expression col_eq_bv = binary_operator(make_column("a"), oper_t::EQ, bv);
+    BOOST_REQUIRE_EQUAL(fold_constants(col_eq_bv, options), binary_operator(make_column("a"), oper_t::EQ, make_int(123)));
+
+    expression col_in_list = binary_operator(make_column("a"), oper_t::IN,
+            collection_constructor{
+                .style = collection_constructor::style_type::list,
+                .elements = {bv, make_int(456)},
+                .type = list_type_impl::get_instance(int32_type, true),
+            });
+    expression folded_rhs = as<binary_operator>(fold_constants(col_in_list, options)).rhs;
+    BOOST_REQUIRE(is<constant>(folded_rhs));
+    BOOST_REQUIRE(evaluate(folded_rhs, options) == evaluate(as<binary_operator>(col_in_list).rhs, options));
+
+    // A bind variable without a value is left alone, so that binding fails
+    // when the expression is evaluated, like before folding.
+    query_options no_values(std::vector<raw_value>{});
+    BOOST_REQUIRE_EQUAL(fold_constants(col_eq_bv, no_values), col_eq_bv);
+}
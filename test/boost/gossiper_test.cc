@@ -0,0 +1,100 @@
+/*
+ * Copyright (C) 2022-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#include <boost/test/unit_test.hpp>
+#include <seastar/testing/test_case.hh>
+#include <seastar/core/smp.hh>
+
+#include "gms/gossiper.hh"
+#include "test/lib/cql_test_env.hh"
+
+using app_states = std::map<gms::application_state, gms::versioned_value>;
+using endpoint_app_states = std::unordered_map<gms::inet_address, app_states>;
+
+static endpoint_app_states get_app_states(const gms::gossiper& g) {
+    endpoint_app_states ret;
+    for (auto&& [ep, es] : g.get_endpoint_states()) {
+        ret.emplace(ep, es.get_application_state_map());
+    }
+    return ret;
+}
+
+static void check_replicated(sharded<gms::gossiper>& gossiper) {
+    auto expected = get_app_states(gossiper.local());
+    gossiper.invoke_on_all([&expected] (gms::gossiper& g) {
+        auto actual = get_app_states(g);
+        BOOST_REQUIRE_EQUAL(actual.size(), expected.size());
+        for (auto&& [ep, states] : expected) {
+            BOOST_REQUIRE(actual.contains(ep));
+            BOOST_REQUIRE(actual[ep] == states);
+        }
+    }).get();
+}
+
+// Endpoints applied concurrently have their states replicated in shared batches.
+// Every shard has to end up with the same application states as shard 0.
+SEASTAR_TEST_CASE(test_concurrently_applied_states_are_replicated) {
+    return do_with_cql_env_thread([] (cql_test_env& e) {
+        auto& gossiper = e.gossiper();
+        const int nr_endpoints = 20;
+
+        std::vector<gms::inet_address> endpoints;
+        for (int i = 0; i < nr_endpoints; ++i) {
+            endpoints.emplace_back(format("127.0.1.{}", i + 1));
+        }
+        // The generation has to match for the states to be applied incrementally,
+        // so start from saved endpoints, like a node does on restart.
+        for (auto&& ep : endpoints) {
+            gossiper.local().add_saved_endpoint(ep).get();
+        }
+        check_replicated(gossiper);
+
+        // A dead STATUS keeps the gossiper from echoing the fake endpoints.
+        auto make_states = [&] (int round) {
+            std::map<gms::inet_address, gms::endpoint_state> states;
+            for (int i = 0; i < nr_endpoints; ++i) {
+                app_states s;
+                s.emplace(gms::application_state::STATUS, gms::versioned_value::left({}, 0));
+                s.emplace(gms::application_state::LOAD, gms::versioned_value::load(round * nr_endpoints + i));
+                if (i % 2) {
+                    s.emplace(gms::application_state::RPC_READY, gms::versioned_value::cql_ready(round % 2));
+                }
+                states.emplace(endpoints[i], gms::endpoint_state(gms::heart_beat_state(0, round + 1), s));
+            }
+            return states;
+        };
+
+        // Several gossip messages applied at once.
+        auto f1 = gossiper.local().apply_state_locally(make_states(0));
+        auto f2 = gossiper.local().apply_state_locally(make_states(1));
+        when_all_succeed(std::move(f1), std::move(f2)).discard_result().get();
+        check_replicated(gossiper);
+
+        for (int i = 0; i < nr_endpoints; ++i) {
+            auto* load = gossiper.local().get_application_state_ptr(endpoints[i], gms::application_state::LOAD);
+            BOOST_REQUIRE(load);
+            BOOST_REQUIRE_EQUAL(load->value, gms::versioned_value::load(nr_endpoints + i).value);
+        }
+
+        // Only newer versions of some states.
+        auto states = make_states(2);
+        for (auto&& [ep, es] : states) {
+            es.get_application_state_map().erase(gms::application_state::STATUS);
+        }
+        gossiper.local().apply_state_locally(std::move(states)).get();
+        check_replicated(gossiper);
+
+        // A heartbeat-only update doesn't change anything to replicate.
+        states.clear();
+        for (auto&& ep : endpoints) {
+            states.emplace(ep, gms::endpoint_state(gms::heart_beat_state(0, 100)));
+        }
+        gossiper.local().apply_state_locally(std::move(states)).get();
+        check_replicated(gossiper);
+    });
+}
@@ -11,6 +11,8 @@
 #include <seastar/core/smp.hh>
 
 #include "db/hints/sync_point.hh"
+#include "db/hints/manager.hh"
+#include "utils/fragmented_temporary_buffer.hh"
 
 SEASTAR_TEST_CASE(test_hint_sync_point_faithful_reserialization) {
     const unsigned encoded_shard_count = 2;
@@ -65,3 +67,145 @@ SEASTAR_TEST_CASE(test_hint_sync_point_faithful_reserialization) {
 
     return make_ready_future<>();
 }
+
+class hint_sender_test {
+public:
+    using sender = db::hints::manager::end_point_hints_manager::sender;
+    using send_one_file_ctx = sender::send_one_file_ctx;
+    static constexpr size_t max_hints_per_batch = sender::max_hints_per_batch;
+    static constexpr size_t max_hint_batch_size = sender::max_hint_batch_size;
+};
+
+using send_one_file_ctx = hint_sender_test::send_one_file_ctx;
+
+static db::replay_position make_rp(uint32_t pos) {
+    return db::replay_position(this_shard_id(), 1, pos);
+}
+
+// Hints read from a segment, sent in batches, see sender::add_hint_to_batch() and sender::send_hint_batch().
+static std::vector<std::vector<db::replay_position>> replay_in_batches(send_one_file_ctx& ctx, const std::vector<size_t>& hint_sizes) {
+    std::vector<std::vector<db::replay_position>> batches;
+    auto send_batch = [&] {
+        auto hints = ctx.take_batch();
+        if (!hints.empty()) {
+            auto& rps = batches.emplace_back();
+            for (auto& h : hints) {
+                rps.push_back(h.rp);
+            }
+        }
+    };
+    for (uint32_t i = 0; i < hint_sizes.size(); ++i) {
+        if (ctx.add_to_batch(fragmented_temporary_buffer::allocate_to_fit(hint_sizes[i]), make_rp(i + 1))) {
+            send_batch();
+        }
+    }
+    // The end of the segment sends the hints which didn't fill a whole batch.
+    send_batch();
+    return batches;
+}
+
+SEASTAR_TEST_CASE(test_hint_batches_are_cut_at_limits) {
+    std::unordered_map<table_schema_version, column_mapping> column_mappings;
+
+    // Cut at the number of hints, with the leftover sent at the end of the segment.
+    {
+        send_one_file_ctx ctx(column_mappings);
+        auto batches = replay_in_batches(ctx, std::vector<size_t>(2 * hint_sender_test::max_hints_per_batch + 10, 100));
+        BOOST_REQUIRE_EQUAL(batches.size(), 3u);
+        BOOST_REQUIRE_EQUAL(batches[0].size(), hint_sender_test::max_hints_per_batch);
+        BOOST_REQUIRE_EQUAL(batches[1].size(), hint_sender_test::max_hints_per_batch);
+        BOOST_REQUIRE_EQUAL(batches[2].size(), 10u);
+        // Hints are sent in replay position order.
+        BOOST_REQUIRE_EQUAL(batches[1].front(), make_rp(hint_sender_test::max_hints_per_batch + 1));
+        BOOST_REQUIRE_EQUAL(batches[2].back(), make_rp(2 * hint_sender_test::max_hints_per_batch + 10));
+    }
+
+    // Cut at the size of hints.
+    {
+        send_one_file_ctx ctx(column_mappings);
+        auto batches = replay_in_batches(ctx, std::vector<size_t>(6, hint_sender_test::max_hint_batch_size / 4));
+        BOOST_REQUIRE_EQUAL(batches.size(), 2u);
+        BOOST_REQUIRE_EQUAL(batches[0].size(), 4u);
+        BOOST_REQUIRE_EQUAL(batches[1].size(), 2u);
+    }
+
+    // A single hint larger than the limit is sent on its own.
+    {
+        send_one_file_ctx ctx(column_mappings);
+        auto batches = replay_in_batches(ctx, {hint_sender_test::max_hint_batch_size + 1, 100});
+        BOOST_REQUIRE_EQUAL(batches.size(), 2u);
+        BOOST_REQUIRE_EQUAL(batches[0].size(), 1u);
+        BOOST_REQUIRE_EQUAL(batches[1].size(), 1u);
+    }
+
+    return make_ready_future<>();
+}
+
+SEASTAR_TEST_CASE(test_hint_batch_replay_succeeds) {
+    std::unordered_map<table_schema_version, column_mapping> column_mappings;
+    send_one_file_ctx ctx(column_mappings);
+
+    auto batches = replay_in_batches(ctx, std::vector<size_t>(10, 100));
+    BOOST_REQUIRE_EQUAL(batches.size(), 1u);
+
+    // Replay waiters are not released while the batch is in flight.
+    BOOST_REQUIRE_EQUAL(ctx.get_replayed_bound(), make_rp(1));
+
+    for (auto rp : batches[0]) {
+        ctx.on_hint_send_success(rp);
+    }
+    // The segment was replayed in full, so it is deleted,
+    // and waiters for any of its hints are released.
+    BOOST_REQUIRE(!ctx.segment_replay_failed);
+    BOOST_REQUIRE_EQUAL(ctx.get_replayed_bound(), make_rp(11));
+
+    return make_ready_future<>();
+}
+
+SEASTAR_TEST_CASE(test_hint_batch_replay_fails_for_one_hint) {
+    std::unordered_map<table_schema_version, column_mapping> column_mappings;
+    send_one_file_ctx ctx(column_mappings);
+
+    auto batches = replay_in_batches(ctx, std::vector<size_t>(6, 100));
+    BOOST_REQUIRE_EQUAL(batches.size(), 1u);
+
+    // Batches are sent in token order, so hints complete out of replay position order.
+    // Hint 3 fails, e.g. because its target is no longer a replica and sending it
+    // to the new replicas failed, while the other hints are sent with the batch RPC.
+    for (auto i : {5, 2, 6, 4, 1}) {
+        ctx.on_hint_send_success(make_rp(i));
+    }
+    BOOST_REQUIRE_EQUAL(ctx.get_replayed_bound(), make_rp(3));
+    ctx.on_hint_send_failure(make_rp(3));
+
+    // The segment is kept and replayed again from the failed hint.
+    BOOST_REQUIRE(ctx.segment_replay_failed);
+    BOOST_REQUIRE_EQUAL(ctx.get_retry_position(db::replay_position()), make_rp(3));
+    BOOST_REQUIRE_EQUAL(ctx.get_replayed_bound(), make_rp(3));
+
+    return make_ready_future<>();
+}
+
+SEASTAR_TEST_CASE(test_hint_batch_replay_interrupted) {
+    std::unordered_map<table_schema_version, column_mapping> column_mappings;
+    send_one_file_ctx ctx(column_mappings);
+
+    // The segment couldn't be read past hint 4, e.g. because of an I/O error,
+    // after the hints read until then were sent.
+    auto batches = replay_in_batches(ctx, std::vector<size_t>(4, 100));
+    for (auto rp : batches[0]) {
+        ctx.on_hint_send_success(rp);
+    }
+    ctx.segment_replay_failed = true;
+
+    // The segment is kept and replayed again from the last hint which was sent.
+    BOOST_REQUIRE_EQUAL(ctx.get_retry_position(make_rp(1)), make_rp(4));
+    BOOST_REQUIRE_EQUAL(ctx.get_replayed_bound(), make_rp(5));
+
+    // Nothing was sent at all, so the next replay starts where this one did.
+    send_one_file_ctx nothing_sent_ctx(column_mappings);
+    nothing_sent_ctx.segment_replay_failed = true;
+    BOOST_REQUIRE_EQUAL(nothing_sent_ctx.get_retry_position(make_rp(7)), make_rp(7));
+
+    return make_ready_future<>();
+}
@@ -113,3 +113,59 @@ SEASTAR_TEST_CASE(test_use_high_bits_of_remaining_rows_in_paging_state_filtering
         }
     });
 }
+
+// Pages cut short by their byte budget, and fetched fast enough, double the
+// budget carried by the paging state to the next page.
+SEASTAR_TEST_CASE(test_adaptive_paging_grows_page_byte_budget) {
+    cql_test_config cfg;
+    cfg.db_config->adaptive_paging_target_latency_in_ms(3600 * 1000);
+    return do_with_cql_env_thread([] (cql_test_env& e) {
+        e.execute_cql("CREATE TABLE test (pk int, ck int, v text, PRIMARY KEY (pk, ck));").get();
+        auto id = e.prepare("INSERT INTO test (pk, ck, v) VALUES (?, ?, ?);").get0();
+        const auto cql3_pk = cql3::raw_value::make_value(int32_type->decompose(data_value(0)));
+        const auto cql3_v = cql3::raw_value::make_value(utf8_type->decompose(data_value(sstring(16 * 1024, 'x'))));
+
+        for (int i = 0; i < 100; i++) {
+            const auto cql3_ck = cql3::raw_value::make_value(int32_type->decompose(data_value(i)));
+            e.execute_prepared(id, {cql3_pk, cql3_ck, cql3_v}).get();
+        }
+
+        auto qo = std::make_unique<cql3::query_options>(db::consistency_level::LOCAL_ONE, std::vector<cql3::raw_value>{},
+                    cql3::query_options::specific_options{40, nullptr, {}, api::new_timestamp()});
+        auto msg = e.execute_cql("SELECT * FROM test;", std::move(qo)).get0();
+        auto paging_state = extract_paging_state(msg);
+        BOOST_REQUIRE(paging_state);
+        // The first page fits in the default page size and is not cut short.
+        BOOST_REQUIRE_EQUAL(paging_state->get_page_byte_budget(), 0);
+
+        const uint64_t budget = 64 * 1024;
+        paging_state->set_page_byte_budget(budget);
+        qo = std::make_unique<cql3::query_options>(db::consistency_level::LOCAL_ONE, std::vector<cql3::raw_value>{},
+                cql3::query_options::specific_options{40, paging_state, {}, api::new_timestamp()});
+        msg = e.execute_cql("SELECT * FROM test;", std::move(qo)).get0();
+        BOOST_REQUIRE(has_more_pages(msg));
+        BOOST_REQUIRE_LT(count_rows_fetched(msg), 40);
+        paging_state = extract_paging_state(msg);
+        BOOST_REQUIRE(paging_state);
+        BOOST_REQUIRE_EQUAL(paging_state->get_page_byte_budget(), 2 * budget);
+
+        // Budgets out of range, e.g. forged by the client, are clamped.
+        paging_state->set_page_byte_budget(1);
+        qo = std::make_unique<cql3::query_options>(db::consistency_level::LOCAL_ONE, std::vector<cql3::raw_value>{},
+                cql3::query_options::specific_options{40, paging_state, {}, api::new_timestamp()});
+        msg = e.execute_cql("SELECT * FROM test;", std::move(qo)).get0();
+        BOOST_REQUIRE(has_more_pages(msg));
+        BOOST_REQUIRE_GT(count_rows_fetched(msg), 1);
+        paging_state = extract_paging_state(msg);
+        BOOST_REQUIRE(paging_state);
+        BOOST_REQUIRE_EQUAL(paging_state->get_page_byte_budget(), 2 * budget);
+
+        paging_state->set_page_byte_budget(std::numeric_limits<uint64_t>::max());
+        qo = std::make_unique<cql3::query_options>(db::consistency_level::LOCAL_ONE, std::vector<cql3::raw_value>{},
+                cql3::query_options::specific_options{40, paging_state, {}, api::new_timestamp()});
+        msg = e.execute_cql("SELECT * FROM test;", std::move(qo)).get0();
+        paging_state = extract_paging_state(msg);
+        BOOST_REQUIRE(paging_state);
+        BOOST_REQUIRE_EQUAL(paging_state->get_page_byte_budget(), query::result_memory_limiter::maximum_result_size);
+    }, std::move(cfg));
+}
@@ -443,3 +443,38 @@ BOOST_AUTO_TEST_CASE(test_reset) {
     BOOST_TEST(matches(m, u8"alpha"));
     BOOST_TEST(!matches(m, u8"omega"));
 }
+
+BOOST_AUTO_TEST_CASE(test_prefix_suffix_overlap) {
+    auto m = matcher(u8"ab%ba");
+    BOOST_TEST(matches(m, u8"abba"));
+    BOOST_TEST(matches(m, u8"abxba"));
+    BOOST_TEST(!matches(m, u8"aba"));
+    BOOST_TEST(!matches(m, u8"ab"));
+}
+
+BOOST_AUTO_TEST_CASE(test_multiple_infixes) {
+    auto m = matcher(u8"%Ш%b%Ш%");
+    BOOST_TEST(matches(m, u8"ШbШ"));
+    BOOST_TEST(matches(m, u8"xxШxxbxxШxx"));
+    BOOST_TEST(matches(m, u8"ШbbШb"));
+    BOOST_TEST(!matches(m, u8"ШШb"));
+    BOOST_TEST(!matches(m, u8"bШ"));
+    BOOST_TEST(!matches(m, u8""));
+
+    auto anchored = matcher(u8"a%b%c");
+    BOOST_TEST(matches(anchored, u8"abc"));
+    BOOST_TEST(matches(anchored, u8"abcbc"));
+    BOOST_TEST(!matches(anchored, u8"abcb"));
+    BOOST_TEST(!matches(anchored, u8"acb"));
+}
+
+BOOST_AUTO_TEST_CASE(test_reset_wildcards) {
+    auto m = matcher(u8"a%");
+    BOOST_TEST(matches(m, u8"abc"));
+    m.reset(bytes(reinterpret_cast<const char*>(u8"a_c")));
+    BOOST_TEST(matches(m, u8"abc"));
+    BOOST_TEST(!matches(m, u8"ab"));
+    m.reset(bytes(reinterpret_cast<const char*>(u8"%c")));
+    BOOST_TEST(matches(m, u8"abc"));
+    BOOST_TEST(!matches(m, u8"abcd"));
+}
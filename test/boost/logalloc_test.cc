@@ -1534,6 +1534,79 @@ SEASTAR_THREAD_TEST_CASE(background_reclaim) {
     }
 }
 
+SEASTAR_THREAD_TEST_CASE(background_defragment) {
+    // Return free segments to the standard allocator, so that the pool starts
+    // below the goal and the background reclaimer doesn't see low memory.
+    shard_tracker().reclaim_all_free_segments();
+    if (memory::stats().free_memory() < 2 * 60'000'000) {
+        testlog.info("Not enough free memory to test background defragmentation, skipping");
+        return;
+    }
+
+    auto free_segments = [] {
+        return (shard_tracker().occupancy().total_space() - shard_tracker().region_occupancy().total_space()) / segment_size;
+    };
+
+    region reg;
+    std::vector<managed_bytes> objs;
+
+    auto clean_up = defer([&] () noexcept {
+        with_allocator(reg.allocator(), [&] {
+            objs.clear();
+        });
+    });
+
+    // Leave 64 segments a quarter full.
+    with_allocator(reg.allocator(), [&] {
+        while (reg.occupancy().total_space() < 64 * segment_size) {
+            objs.emplace_back(managed_bytes::initialized_later(), 1000);
+        }
+        std::vector<managed_bytes> kept;
+        for (size_t i = 0; i < objs.size(); i += 4) {
+            kept.push_back(std::move(objs[i]));
+        }
+        objs = std::move(kept);
+    });
+    shard_tracker().reclaim_all_free_segments();
+
+    // The pool is short of free segments, but the region is fragmented
+    // enough for compaction to make up for them.
+    const size_t goal = 16;
+    BOOST_REQUIRE_LT(free_segments(), goal);
+    BOOST_REQUIRE_GE(reg.occupancy().free_space(), 2 * goal * segment_size);
+
+    auto total_space_before = reg.occupancy().total_space();
+    auto compacted_before = logalloc::memory_compacted();
+
+    auto background_reclaim_scheduling_group = create_scheduling_group("background_defragment", 100).get0();
+    auto kill_sched_group = defer([&] () noexcept {
+        destroy_scheduling_group(background_reclaim_scheduling_group).get();
+    });
+
+    logalloc::tracker::config st_cfg;
+    st_cfg.defragment_on_idle = false;
+    st_cfg.abort_on_lsa_bad_alloc = false;
+    st_cfg.lsa_reclamation_step = 1;
+    st_cfg.background_reclaim_sched_group = background_reclaim_scheduling_group;
+    st_cfg.defragment_free_segments_goal = goal;
+    logalloc::shard_tracker().configure(st_cfg);
+
+    auto stop_lsa_background_reclaim = defer([&] () noexcept {
+        logalloc::shard_tracker().stop().get();
+    });
+
+    auto deadline = lowres_clock::now() + 10s;
+    while (free_segments() < goal && lowres_clock::now() < deadline) {
+        sleep(10ms).get();
+    }
+
+    BOOST_REQUIRE_GE(free_segments(), goal);
+    BOOST_REQUIRE_LT(reg.occupancy().total_space(), total_space_before);
+    BOOST_REQUIRE_GT(logalloc::memory_compacted(), compacted_before);
+    // Only sparse segments are compacted and only until the goal is met.
+    BOOST_REQUIRE_GE(reg.occupancy().total_space(), total_space_before - 2 * goal * segment_size);
+}
+
 inline
 bool is_aligned(void* ptr, size_t alignment) {
     return uintptr_t(ptr) % alignment == 0;
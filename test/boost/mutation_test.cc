@@ -2483,6 +2483,61 @@ SEASTAR_THREAD_TEST_CASE(test_appending_hash_row_4567) {
     BOOST_CHECK_EQUAL(compute_legacy_hash(r1, { 0, 1, 2 }), compute_legacy_hash(r2, { 0, 1, 2 }));
 }
 
+SEASTAR_THREAD_TEST_CASE(test_compressed_atomic_cells) {
+    auto s = schema_builder("ks", "cf")
+        .with_column("pk", bytes_type, column_kind::partition_key)
+        .with_column("v", bytes_type)
+        .build();
+    auto& cdef = *s->get_column_definition("v");
+
+    auto value = bytes(4096, int8_t('a'));
+    auto plain = atomic_cell::make_live(*bytes_type, 1, value);
+
+    BOOST_REQUIRE(!atomic_cell::make_compressed(atomic_cell::make_live(*bytes_type, 1, to_bytes("aaa"))));
+    BOOST_REQUIRE(!atomic_cell::make_compressed(atomic_cell::make_dead(1, gc_clock::now())));
+
+    auto compressed = atomic_cell::make_compressed(plain);
+    BOOST_REQUIRE(compressed);
+    BOOST_REQUIRE(atomic_cell_view(*compressed).is_compressed());
+    BOOST_REQUIRE_LT(atomic_cell_view(*compressed).value().size_bytes(), value.size());
+    BOOST_REQUIRE_EQUAL(atomic_cell_view(*compressed).timestamp(), plain.timestamp());
+
+    auto decompressed = atomic_cell::make_decompressed(*compressed);
+    BOOST_REQUIRE(!atomic_cell_view(decompressed).is_compressed());
+    BOOST_REQUIRE(atomic_cell_view(decompressed).value() == managed_bytes_view(bytes_view(value)));
+
+    // Timestamp ties are broken by comparing values, compressed or not.
+    BOOST_REQUIRE(compare_atomic_cell_for_merge(*compressed, plain) == 0);
+    BOOST_REQUIRE(compare_atomic_cell_for_merge(plain, *compressed) == 0);
+    auto greater = atomic_cell::make_live(*bytes_type, 1, bytes(4096, int8_t('b')));
+    BOOST_REQUIRE(compare_atomic_cell_for_merge(*compressed, greater) < 0);
+    BOOST_REQUIRE(compare_atomic_cell_for_merge(greater, *compressed) > 0);
+    auto greater_compressed = atomic_cell::make_compressed(greater);
+    BOOST_REQUIRE(greater_compressed);
+    BOOST_REQUIRE(compare_atomic_cell_for_merge(*compressed, *greater_compressed) < 0);
+    BOOST_REQUIRE(compare_atomic_cell_for_merge(*greater_compressed, plain) > 0);
+
+    BOOST_REQUIRE(atomic_cell_or_collection(atomic_cell(*bytes_type, *compressed)).equals(*bytes_type, atomic_cell_or_collection(atomic_cell(*bytes_type, plain))));
+    BOOST_REQUIRE(!atomic_cell_or_collection(atomic_cell(*bytes_type, *compressed)).equals(*bytes_type, atomic_cell_or_collection(atomic_cell(*bytes_type, greater))));
+
+    // Digests must not depend on whether the replica keeps the cell compressed.
+    auto hash_of = [&] (const row& r) {
+        auto hasher = xx_hasher{};
+        max_timestamp ts;
+        appending_hash<row>{}(hasher, r, *s, column_kind::regular_column, { cdef.id }, ts);
+        return hasher.finalize_uint64();
+    };
+    auto plain_row = row();
+    plain_row.append_cell(cdef.id, atomic_cell(*bytes_type, plain));
+    auto compressed_row = row(*s, column_kind::regular_column, plain_row);
+    compressed_row.compress_cells(*s, column_kind::regular_column);
+    BOOST_REQUIRE(compressed_row.has_compressed_cells(*s, column_kind::regular_column));
+    BOOST_REQUIRE_EQUAL(hash_of(compressed_row), hash_of(plain_row));
+    compressed_row.decompress_cells(*s, column_kind::regular_column);
+    BOOST_REQUIRE(!compressed_row.has_compressed_cells(*s, column_kind::regular_column));
+    BOOST_REQUIRE(compressed_row.equal(column_kind::regular_column, *s, plain_row, *s));
+}
+
 SEASTAR_THREAD_TEST_CASE(test_mutation_consume) {
     std::mt19937 engine(tests::random::get_int<uint32_t>());
 
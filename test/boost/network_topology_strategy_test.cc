@@ -626,6 +626,69 @@ SEASTAR_THREAD_TEST_CASE(testCalculateEndpoints) {
     }
 }
 
+SEASTAR_THREAD_TEST_CASE(test_incremental_effective_replication_map) {
+    utils::fb_utilities::set_broadcast_address(gms::inet_address("localhost"));
+    utils::fb_utilities::set_broadcast_rpc_address(gms::inet_address("localhost"));
+
+    snitch_config cfg;
+    cfg.name = "RackInferringSnitch";
+    sharded<gms::gossiper> g;
+    sharded<snitch_ptr>& snitch = i_endpoint_snitch::snitch_instance();
+    snitch.start(cfg, std::ref(g)).get();
+    auto stop_snitch = defer([&snitch] { snitch.stop().get(); });
+    snitch.invoke_on_all(&snitch_ptr::start).get();
+
+    locator::shared_token_metadata stm([] () noexcept { return db::schema_tables::hold_merge_lock(); });
+
+    constexpr size_t VNODES = 16;
+    std::vector<inet_address> nodes = {
+        inet_address("192.100.10.1"), inet_address("192.100.20.1"), inet_address("192.100.30.1"),
+        inet_address("192.101.10.1"), inet_address("192.101.20.1"), inet_address("192.101.30.1"),
+        inet_address("192.102.10.1"), inet_address("192.102.20.1"), inet_address("192.102.40.1"),
+        inet_address("192.102.40.2"),
+    };
+    std::unordered_map<inet_address, std::unordered_set<token>> endpoint_tokens;
+    std::unordered_set<token> all_tokens;
+    for (auto& node : nodes) {
+        while (endpoint_tokens[node].size() < VNODES) {
+            auto t = dht::token::get_random_token();
+            if (all_tokens.insert(t).second) {
+                endpoint_tokens[node].insert(t);
+            }
+        }
+    }
+    stm.mutate_token_metadata([&endpoint_tokens] (token_metadata& tm) {
+        return tm.update_normal_tokens(endpoint_tokens);
+    }).get();
+
+    std::vector<abstract_replication_strategy::ptr_type> strategies = {
+        abstract_replication_strategy::create_replication_strategy("NetworkTopologyStrategy", {{"100", "3"}, {"101", "2"}, {"102", "3"}}),
+        abstract_replication_strategy::create_replication_strategy("SimpleStrategy", {{"replication_factor", "3"}}),
+    };
+    std::vector<effective_replication_map_ptr> previous;
+    for (auto& rs : strategies) {
+        previous.push_back(calculate_effective_replication_map(rs, stm.get()).get0());
+    }
+
+    // Move a token to another node, drop a token and add one, without
+    // changing the topology.
+    auto moved = *endpoint_tokens[nodes[0]].begin();
+    endpoint_tokens[nodes[0]].erase(moved);
+    endpoint_tokens[nodes[5]].insert(moved);
+    endpoint_tokens[nodes[7]].erase(endpoint_tokens[nodes[7]].begin());
+    while (!endpoint_tokens[nodes[9]].insert(dht::token::get_random_token()).second) {
+    }
+    stm.mutate_token_metadata([&endpoint_tokens] (token_metadata& tm) {
+        return tm.update_normal_tokens(endpoint_tokens);
+    }).get();
+
+    for (size_t i = 0; i < strategies.size(); ++i) {
+        auto full = calculate_effective_replication_map(strategies[i], stm.get()).get0();
+        auto incremental = calculate_effective_replication_map(strategies[i], stm.get(), previous[i]).get0();
+        BOOST_REQUIRE(incremental->get_replication_map() == full->get_replication_map());
+    }
+}
+
 SEASTAR_TEST_CASE(test_invalid_dcs) {
     return do_with_cql_env_thread([] (auto& e) {
         for (auto& incorrect : std::vector<std::string>{"3\"", "", "!!!", "abcb", "!3", "-5", "0x123", "999999999999999999999999999999"}) {
@@ -277,6 +277,21 @@ class test_querier_cache {
         return produce_first_page_and_save_data_querier(1);
     }
 
+    // Saves the data querier of a scan `pages` times, like a paged query does
+    // after each of its pages. Pages after the first one are empty, so the
+    // returned entry describes the last save too.
+    entry_info produce_pages_and_save_data_querier(unsigned key, unsigned pages) {
+        auto entry = produce_first_page_and_save_data_querier(key);
+        for (unsigned page = 1; page < pages; ++page) {
+            auto querier_opt = _cache.lookup_data_querier(make_cache_key(key), *_s.schema(), entry.expected_range, entry.expected_slice, nullptr, db::no_timeout);
+            ++_expected_stats.lookups;
+            BOOST_REQUIRE(querier_opt);
+            _cache.insert_data_querier(make_cache_key(key), std::move(*querier_opt), nullptr);
+        }
+        BOOST_REQUIRE_EQUAL(entry.permit.saved_pages(), pages);
+        return entry;
+    }
+
     entry_info produce_first_page_and_save_mutation_querier(unsigned key, const dht::partition_range& range,
             const query::partition_slice& slice, uint64_t row_limit = 5) {
         return produce_first_page_and_save_querier<query::querier>(&query::querier_cache::insert_mutation_querier, key, range, slice, row_limit);
@@ -566,6 +581,47 @@ SEASTAR_THREAD_TEST_CASE(test_time_based_cache_eviction) {
     BOOST_REQUIRE_EQUAL(t.get_semaphore().get_stats().inactive_reads, 0);
 }
 
+SEASTAR_THREAD_TEST_CASE(test_established_scan_cache_eviction) {
+    const auto established = query::querier_cache::established_scan_pages;
+    static_assert(query::querier_cache::established_scan_ttl_factor == 3);
+
+    // A scan one page short of being established gets the default TTL.
+    {
+        test_querier_cache t(1s);
+
+        const auto entry = t.produce_pages_and_save_data_querier(1, established - 1);
+
+        seastar::sleep(1500ms).get();
+
+        t.assert_cache_lookup_data_querier(entry.key, *t.get_schema(), entry.expected_range, entry.expected_slice)
+            .misses()
+            .no_drops()
+            .time_based_evictions();
+    }
+
+    // Established scans stay cached three times longer.
+    {
+        test_querier_cache t(1s);
+
+        const auto entry1 = t.produce_pages_and_save_data_querier(1, established);
+        const auto entry2 = t.produce_pages_and_save_data_querier(2, established);
+
+        seastar::sleep(1500ms).get();
+
+        t.assert_cache_lookup_data_querier(entry1.key, *t.get_schema(), entry1.expected_range, entry1.expected_slice)
+            .no_misses()
+            .no_drops()
+            .no_evictions();
+
+        seastar::sleep(2s).get();
+
+        t.assert_cache_lookup_data_querier(entry2.key, *t.get_schema(), entry2.expected_range, entry2.expected_slice)
+            .misses()
+            .no_drops()
+            .time_based_evictions();
+    }
+}
+
 sstring make_string_blob(size_t size) {
     const char* const letters = "abcdefghijklmnoqprsuvwxyz";
     auto& re = seastar::testing::local_random_engine;
@@ -352,3 +352,36 @@ SEASTAR_TEST_CASE(test_select_full_scan_metrics) {
         BOOST_CHECK_EQUAL(stat_ps8, qp.get_cql_stats().select_partition_range_scan);
     });
 }
+
+SEASTAR_TEST_CASE(test_prepared_statements_index) {
+    return do_with_cql_env_thread([] (cql_test_env& e) {
+        e.execute_cql("create table ks.cf (p int primary key, v int);").get();
+        const sstring query = "select v from ks.cf where p = ?;";
+        const auto key = cql3::query_processor::compute_id(query, "ks");
+
+        // Statements which were never prepared are not known to the index
+        BOOST_REQUIRE(!e.local_qp().prepare_from_index(key).get0());
+
+        e.local_qp().index_prepared_statement(query, "ks").get();
+        // The index doesn't depend on the owner shard having the statement cached
+        e.qp().invoke_on(cql3::query_processor::prepared_statement_owner(key), [key] (cql3::query_processor& qp) {
+            BOOST_REQUIRE(!qp.get_prepared(key));
+        }).get();
+        e.qp().invoke_on_all([key] (cql3::query_processor& qp) {
+            return qp.prepare_from_index(key).then([&qp, key] (bool found) {
+                BOOST_REQUIRE(found);
+                BOOST_REQUIRE(qp.get_prepared(key));
+            });
+        }).get();
+
+        // Invalidating the statement drops it from the index, so that clients
+        // have to prepare it again and learn about the new metadata
+        e.execute_cql("alter table ks.cf add w int;").get();
+        e.qp().invoke_on_all([key] (cql3::query_processor& qp) {
+            return qp.prepare_from_index(key).then([&qp, key] (bool found) {
+                BOOST_REQUIRE(!found);
+                BOOST_REQUIRE(!qp.get_prepared(key));
+            });
+        }).get();
+    });
+}
@@ -915,3 +915,80 @@ SEASTAR_THREAD_TEST_CASE(test_reader_concurrency_semaphore_used_blocked) {
         }
     }
 }
+
+SEASTAR_THREAD_TEST_CASE(test_reader_concurrency_semaphore_admission_lanes) {
+    using admission_lane = reader_concurrency_semaphore::admission_lane;
+    reader_concurrency_semaphore semaphore(reader_concurrency_semaphore::for_tests{}, get_name(), 1, replica::new_reader_base_cost);
+    auto stop_sem = deferred_stop(semaphore);
+
+    std::vector<sstring> admitted;
+    std::vector<future<>> reads;
+    unsigned estimates = 0;
+    auto enqueue = [&] (sstring name, admission_lane lane) {
+        reads.emplace_back(semaphore.with_permit(nullptr, "read", replica::new_reader_base_cost, db::no_timeout, [&admitted, name] (reader_permit) {
+            admitted.push_back(name);
+            return make_ready_future<>();
+        }, [&estimates, lane] {
+            ++estimates;
+            return lane;
+        }));
+    };
+
+    // Reads admitted right away don't estimate their lane.
+    enqueue("first", admission_lane::light);
+    reads.back().get();
+    reads.clear();
+    admitted.clear();
+    BOOST_REQUIRE_EQUAL(estimates, 0);
+
+    {
+        auto permit = semaphore.obtain_permit(nullptr, "blocker", replica::new_reader_base_cost, db::no_timeout).get();
+
+        enqueue("heavy1", admission_lane::heavy);
+        enqueue("heavy2", admission_lane::heavy);
+        for (unsigned i = 1; i <= reader_concurrency_semaphore::light_lane_weight + 1; ++i) {
+            enqueue(format("light{}", i), admission_lane::light);
+        }
+        BOOST_REQUIRE_EQUAL(semaphore.waiters(), reader_concurrency_semaphore::light_lane_weight + 3);
+        BOOST_REQUIRE_EQUAL(semaphore.get_stats().light_reads_enqueued, reader_concurrency_semaphore::light_lane_weight + 1);
+        BOOST_REQUIRE_EQUAL(estimates, reader_concurrency_semaphore::light_lane_weight + 3);
+    }
+
+    when_all_succeed(reads.begin(), reads.end()).get();
+
+    // Light reads go first, but not more than light_lane_weight of them in a
+    // row while heavy reads are waiting.
+    const std::vector<sstring> expected{"light1", "light2", "light3", "light4", "heavy1", "light5", "heavy2"};
+    BOOST_REQUIRE(admitted == expected);
+}
+
+SEASTAR_THREAD_TEST_CASE(test_reader_concurrency_semaphore_evict_first) {
+    simple_schema s;
+    reader_concurrency_semaphore semaphore(reader_concurrency_semaphore::no_limits{}, get_name());
+    auto stop_sem = deferred_stop(semaphore);
+
+    auto make_reader = [&] {
+        return make_empty_flat_reader_v2(s.schema(), semaphore.make_tracking_only_permit(s.schema().get(), get_name(), db::no_timeout));
+    };
+
+    auto old_handle = semaphore.register_inactive_read(make_reader());
+    auto evict_first_old_handle = semaphore.register_inactive_read(make_reader(), reader_concurrency_semaphore::evict_first::yes);
+    auto new_handle = semaphore.register_inactive_read(make_reader());
+    auto evict_first_new_handle = semaphore.register_inactive_read(make_reader(), reader_concurrency_semaphore::evict_first::yes);
+
+    // Reads registered with evict_first go first, oldest first too.
+    BOOST_REQUIRE(semaphore.try_evict_one_inactive_read());
+    BOOST_REQUIRE(!evict_first_old_handle);
+    BOOST_REQUIRE(evict_first_new_handle);
+    BOOST_REQUIRE(old_handle);
+    BOOST_REQUIRE(new_handle);
+
+    BOOST_REQUIRE(semaphore.try_evict_one_inactive_read());
+    BOOST_REQUIRE(!evict_first_new_handle);
+    BOOST_REQUIRE(old_handle);
+    BOOST_REQUIRE(new_handle);
+
+    BOOST_REQUIRE(semaphore.try_evict_one_inactive_read());
+    BOOST_REQUIRE(!old_handle);
+    BOOST_REQUIRE(new_handle);
+}
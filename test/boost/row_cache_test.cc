@@ -137,6 +137,130 @@ SEASTAR_TEST_CASE(test_cache_delegates_to_underlying) {
     });
 }
 
+static schema_ptr make_compressed_cache_schema(bool compressed = true) {
+    return schema_builder("ks", "cf")
+        .with_column("pk", bytes_type, column_kind::partition_key)
+        .with_column("ck", int32_type, column_kind::clustering_key)
+        .with_column("s", bytes_type, column_kind::static_column)
+        .with_column("v", bytes_type, column_kind::regular_column)
+        .set_caching_options(caching_options::from_map({{"keys", "ALL"}, {"rows_per_partition", "ALL"}, {"compression", compressed ? "LZ4" : "NONE"}}))
+        .build();
+}
+
+// Values are large and compressible, the cache keeps them compressed.
+// Rows below tie_from are written at the given timestamp, the others at
+// timestamp 1, so they tie with the ones of another such mutation.
+static mutation make_compressible_mutation(schema_ptr s, api::timestamp_type ts, int8_t fill, int tie_from = 10) {
+    mutation m(s, partition_key::from_single_value(*s, to_bytes("key")));
+    m.set_static_cell("s", data_value(bytes(4096, fill)), 1);
+    for (int i = 0; i < 10; ++i) {
+        auto ck = clustering_key::from_single_value(*s, int32_type->decompose(i));
+        m.set_clustered_cell(ck, "v", data_value(bytes(4096, int8_t(fill + i))), i < tie_from ? ts : 1);
+    }
+    return m;
+}
+
+SEASTAR_TEST_CASE(test_cache_with_compressed_cells) {
+    return seastar::async([] {
+        tests::reader_concurrency_semaphore_wrapper semaphore;
+
+        // Returns the memory used by the cache once m is populated.
+        auto populate = [&] (schema_ptr s, const mutation& m) {
+            cache_tracker tracker;
+            row_cache cache(s, snapshot_source_from_snapshot(make_source_with(m)), tracker);
+            // The second read is served from cache.
+            for (int i = 0; i < 2; ++i) {
+                assert_that(cache.make_reader(s, semaphore.make_permit(), query::full_partition_range))
+                    .produces(m)
+                    .produces_end_of_stream();
+            }
+            return tracker.region().occupancy().used_space();
+        };
+
+        auto s = make_compressed_cache_schema();
+        auto plain_s = make_compressed_cache_schema(false);
+        auto compressed_size = populate(s, make_compressible_mutation(s, 1, 'a'));
+        auto plain_size = populate(plain_s, make_compressible_mutation(plain_s, 1, 'a'));
+        BOOST_REQUIRE_LT(compressed_size * 4, plain_size);
+
+        // Static rows are compressed too.
+        auto make_static_only = [] (schema_ptr s) {
+            mutation m(s, partition_key::from_single_value(*s, to_bytes("key")));
+            m.set_static_cell("s", data_value(bytes(64 * 1024, int8_t('s'))), 1);
+            return m;
+        };
+        compressed_size = populate(s, make_static_only(s));
+        plain_size = populate(plain_s, make_static_only(plain_s));
+        BOOST_REQUIRE_LT(compressed_size * 4, plain_size);
+    });
+}
+
+SEASTAR_TEST_CASE(test_cache_update_merges_into_compressed_cells) {
+    return seastar::async([] {
+        auto s = make_compressed_cache_schema();
+        tests::reader_concurrency_semaphore_wrapper semaphore;
+        memtable_snapshot_source underlying(s);
+
+        auto m1 = make_compressible_mutation(s, 1, 'a');
+        underlying.apply(m1);
+
+        cache_tracker tracker;
+        row_cache cache(s, snapshot_source([&] { return underlying(); }), tracker);
+
+        assert_that(cache.make_reader(s, semaphore.make_permit(), query::full_partition_range))
+            .produces(m1)
+            .produces_end_of_stream();
+
+        // Rows 0-4 are overwritten. Rows 5-9 and the static row tie on
+        // timestamps with the compressed cells in cache and win on values.
+        auto m2 = make_compressible_mutation(s, 2, 'a' + 1, 5);
+        auto mt = make_lw_shared<replica::memtable>(s);
+        mt->apply(m2);
+        cache.update(row_cache::external_updater([&] {
+            underlying.apply(m2);
+        }), *mt).get();
+
+        auto expected = m1 + m2;
+        for (int i = 0; i < 2; ++i) {
+            assert_that(cache.make_reader(s, semaphore.make_permit(), query::full_partition_range))
+                .produces(expected)
+                .produces_end_of_stream();
+        }
+    });
+}
+
+SEASTAR_TEST_CASE(test_compressed_cells_after_schema_change) {
+    return seastar::async([] {
+        auto s = make_compressed_cache_schema();
+        auto s2 = schema_builder(s)
+            .with_column("extra", bytes_type, column_kind::regular_column)
+            .build();
+        tests::reader_concurrency_semaphore_wrapper semaphore;
+        memtable_snapshot_source underlying(s);
+
+        auto m = make_compressible_mutation(s, 1, 'a');
+        underlying.apply(m);
+
+        cache_tracker tracker;
+        row_cache cache(s, snapshot_source([&] { return underlying(); }), tracker);
+
+        auto pr = dht::partition_range::make_singular(m.decorated_key());
+        assert_that(cache.make_reader(s, semaphore.make_permit(), pr))
+            .produces(m)
+            .produces_end_of_stream();
+
+        cache.set_schema(s2);
+        auto m_s2 = m;
+        m_s2.upgrade(s2);
+        // The first read upgrades the compressed cells in cache.
+        for (int i = 0; i < 2; ++i) {
+            assert_that(cache.make_reader(s2, semaphore.make_permit(), pr))
+                .produces(m_s2)
+                .produces_end_of_stream();
+        }
+    });
+}
+
 SEASTAR_TEST_CASE(test_cache_works_after_clearing) {
     return seastar::async([] {
         auto s = make_schema();
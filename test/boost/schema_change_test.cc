@@ -834,6 +834,39 @@ SEASTAR_TEST_CASE(test_schema_digest_does_not_change_with_keyspace_storage_optio
         });
 }
 
+SEASTAR_TEST_CASE(test_incremental_schema_digest_matches_full_digest) {
+    return do_with_cql_env_thread([] (cql_test_env& e) {
+        auto& proxy = service::get_storage_proxy();
+        auto check = [&] {
+            auto features = proxy.local().features().cluster_schema_features();
+            auto expected = db::schema_tables::calculate_schema_digest(proxy, features).get0();
+            BOOST_REQUIRE_EQUAL(e.local_db().get_version(), expected);
+        };
+
+        check();
+        e.execute_cql("create keyspace ks1 with replication = { 'class' : 'SimpleStrategy', 'replication_factor' : 1 };").get();
+        check();
+        e.execute_cql("create keyspace ks2 with replication = { 'class' : 'SimpleStrategy', 'replication_factor' : 1 };").get();
+        e.execute_cql("create table ks1.t1 (pk int primary key, v int);").get();
+        e.execute_cql("create table ks2.t2 (pk int primary key, v int);").get();
+        check();
+        e.execute_cql("alter table ks1.t1 add v2 int;").get();
+        check();
+        e.execute_cql("create type ks2.ut (a int, b text);").get();
+        e.execute_cql("create index on ks2.t2 (v);").get();
+        check();
+        e.execute_cql("drop table ks1.t1;").get();
+        check();
+        e.execute_cql("drop keyspace ks2;").get();
+        check();
+        // Recalculating drops the cached digests, the next merge has to reload them.
+        db::schema_tables::recalculate_schema_version(e.get_system_keyspace(), proxy, proxy.local().features()).get();
+        check();
+        e.execute_cql("create table ks1.t3 (pk int primary key, v int);").get();
+        check();
+    });
+}
+
 // Regression test, ensuring people don't forget to set the null sharder
 // for newly added schema tables.
 SEASTAR_TEST_CASE(test_schema_tables_use_null_sharder) {
@@ -32,6 +32,9 @@ class distributed_loader_for_tests {
     static future<> reshard(sharded<sstables::sstable_directory>& dir, sharded<replica::database>& db, sstring ks_name, sstring table_name, sstables::compaction_sstable_creator_fn creator) {
         return replica::distributed_loader::reshard(dir, db, std::move(ks_name), std::move(table_name), std::move(creator));
     }
+    static future<> reshape(sharded<sstables::sstable_directory>& dir, sharded<replica::database>& db, sstables::reshape_mode mode, sstring ks_name, sstring table_name, sstables::compaction_sstable_creator_fn creator) {
+        return replica::distributed_loader::reshape(dir, db, mode, std::move(ks_name), std::move(table_name), std::move(creator), sstables::sstable_directory::default_sstable_filter());
+    }
 };
 
 schema_ptr test_table_schema() {
@@ -368,6 +371,28 @@ SEASTAR_THREAD_TEST_CASE(sstable_directory_test_generation_sanity) {
   }).get();
 }
 
+// Test that an sstable loaded with lazy_filter::yes serves every key until its filter is loaded
+SEASTAR_THREAD_TEST_CASE(sstable_directory_test_lazy_filter_loading) {
+  sstables::test_env::do_with_sharded_async([] (sharded<test_env>& env) {
+    auto dir = tmpdir();
+    auto s = test_table_schema();
+    make_sstable_for_this_shard(std::bind(new_sstable, std::ref(env.local()), dir.path(), 1));
+    auto key = partition_key::from_exploded(*s, {to_bytes(token_generation_for_shard(1, this_shard_id(), 12)[0].first)});
+
+    auto sst = new_sstable(env.local(), dir.path(), 1);
+    sst->load(default_priority_class(), sstable::lazy_filter::yes).get();
+    BOOST_REQUIRE(!sst->filter_loaded());
+    BOOST_REQUIRE_EQUAL(sst->filter_memory_size(), 0);
+    BOOST_REQUIRE(sst->filter_has_key(*s, key));
+
+    // Concurrent calls share the read
+    when_all_succeed(sst->load_filter(), sst->load_filter()).get();
+    BOOST_REQUIRE(sst->filter_loaded());
+    BOOST_REQUIRE_GT(sst->filter_memory_size(), 0);
+    BOOST_REQUIRE(sst->filter_has_key(*s, key));
+  }).get();
+}
+
 future<> verify_that_all_sstables_are_local(sharded<sstable_directory>& sstdir, unsigned expected_sstables) {
     return do_with(std::make_unique<std::atomic<unsigned>>(0), [&sstdir, expected_sstables] (std::unique_ptr<std::atomic<unsigned>>& count) {
         return sstdir.invoke_on_all([count = count.get()] (sstable_directory& d) {
@@ -683,3 +708,78 @@ SEASTAR_TEST_CASE(sstable_directory_shared_sstables_reshard_respect_max_threshol
       });
     });
 }
+
+// Test that reshaping SSTables which all belong to a single shard leaves them with their owner,
+// even though other shards help by running some of the reshape jobs.
+SEASTAR_TEST_CASE(sstable_directory_reshape_single_shard_backlog) {
+    return do_with_cql_env_thread([] (cql_test_env& e) {
+        e.execute_cql("create table cf (p text PRIMARY KEY, c int) with compaction = "
+                "{'class': 'SizeTieredCompactionStrategy', 'min_threshold': 4, 'max_threshold': 4}").get();
+        auto& cf = e.local_db().find_column_family("ks", "cf");
+        auto upload_path = fs::path(cf.dir()) / sstables::upload_dir;
+
+        e.db().invoke_on_all([] (replica::database& db) {
+            auto& cf = db.find_column_family("ks", "cf");
+            return cf.disable_auto_compaction();
+        }).get();
+
+        unsigned num_sstables = 16;
+        auto s = cf.schema();
+        auto keys = token_generation_for_shard(num_sstables, 0, e.db().local().get_config().murmur3_partitioner_ignore_msb_bits());
+        for (unsigned nr = 0; nr < num_sstables; ++nr) {
+            mutation m(s, partition_key::from_exploded(*s, {to_bytes(keys[nr].first)}));
+            m.set_clustered_cell(clustering_key::make_empty(), bytes("c"), data_value(int32_t(nr)), api::timestamp_type(0));
+            auto sst = cf.make_sstable(upload_path.native(), generation_from_value(nr * smp::count),
+                    sstables::get_highest_sstable_version(), sstables::sstable::format_types::big);
+            make_sstable_containing([sst] { return sst; }, {m});
+        }
+
+      with_sstable_directory(upload_path, 1,
+                sstable_directory::need_mutate_level::no,
+                sstable_directory::lack_of_toc_fatal::yes,
+                sstable_directory::enable_dangerous_direct_import_of_cassandra_counters::no,
+                sstable_directory::allow_loading_materialized_view::no,
+                [&e] (fs::path dir, generation_type gen, sstables::sstable_version_types v, sstables::sstable_format_types f) {
+                    auto& cf = e.local_db().find_column_family("ks", "cf");
+                    return cf.make_sstable(dir.native(), gen, v, f);
+                },
+                [&e, upload_path, num_sstables] (sharded<sstables::sstable_directory>& sstdir) {
+        distributed_loader_for_tests::process_sstable_dir(sstdir).get();
+
+        int64_t max_generation_seen = highest_generation_seen(sstdir).get0();
+        std::atomic<int64_t> generation_for_test = {};
+        generation_for_test.store(max_generation_seen + 1, std::memory_order_relaxed);
+        // Counts the output SSTables written by the helper shards.
+        std::atomic<unsigned> helped = {};
+
+        distributed_loader_for_tests::reshape(sstdir, e.db(), sstables::reshape_mode::relaxed, "ks", "cf", [&e, upload_path, &generation_for_test, &helped] (shard_id id) {
+            if (this_shard_id() != 0) {
+                helped.fetch_add(1, std::memory_order_relaxed);
+            }
+            auto generation = generation_for_test.fetch_add(1, std::memory_order_relaxed);
+            auto& cf = e.local_db().find_column_family("ks", "cf");
+            return cf.make_sstable(upload_path.native(), generation_from_value(generation), sstables::sstable::version_types::mc, sstables::sstable::format_types::big);
+        }).get();
+
+        auto remaining = sstdir.map_reduce0([] (sstable_directory& d) {
+            return do_with(0u, [&d] (unsigned& count) {
+                return d.do_for_each_sstable([&count] (sstables::shared_sstable sst) {
+                    auto shards = sst->get_shards_for_this_sstable();
+                    BOOST_REQUIRE_EQUAL(shards.size(), 1);
+                    BOOST_REQUIRE_EQUAL(shards[0], this_shard_id());
+                    BOOST_REQUIRE_EQUAL(this_shard_id(), 0);
+                    ++count;
+                    return make_ready_future<>();
+                }).then([&count] {
+                    return count;
+                });
+            });
+        }, 0u, std::plus<unsigned>()).get0();
+        BOOST_REQUIRE_GT(remaining, 0);
+        BOOST_REQUIRE_LT(remaining, num_sstables / 4);
+        if (smp::count > 1) {
+            BOOST_REQUIRE_GT(helped.load(std::memory_order_relaxed), 0u);
+        }
+      });
+    });
+}
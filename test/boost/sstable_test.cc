@@ -872,3 +872,29 @@ BOOST_AUTO_TEST_CASE(test_empty_key_view_comparison) {
     BOOST_CHECK_EQUAL(0, lf.size());
     BOOST_CHECK(lf.begin() == lf.end());
 }
+
+SEASTAR_TEST_CASE(test_read_ahead_controller) {
+    using sstables::read_ahead_controller;
+    constexpr size_t buffer_size = 128 * 1024;
+    read_ahead_controller c;
+    BOOST_REQUIRE_EQUAL(c.read_ahead(), read_ahead_controller::default_read_ahead);
+
+    // Skipping before the read-ahead window is consumed shrinks it, down to the minimum.
+    for (unsigned i = 0; i < 10; ++i) {
+        c.on_skip(buffer_size / 2, buffer_size);
+    }
+    BOOST_REQUIRE_EQUAL(c.read_ahead(), read_ahead_controller::min_read_ahead);
+
+    // A read shorter than two windows leaves it alone.
+    c.on_sequential_read(buffer_size, buffer_size);
+    BOOST_REQUIRE_EQUAL(c.read_ahead(), read_ahead_controller::min_read_ahead);
+
+    // Long sequential reads grow it, up to the maximum, whether they end with a skip or not.
+    c.on_skip(2 * buffer_size, buffer_size);
+    BOOST_REQUIRE_EQUAL(c.read_ahead(), 2 * read_ahead_controller::min_read_ahead);
+    for (unsigned i = 0; i < 10; ++i) {
+        c.on_sequential_read(uint64_t(1) << 40, buffer_size);
+    }
+    BOOST_REQUIRE_EQUAL(c.read_ahead(), read_ahead_controller::max_read_ahead);
+    return make_ready_future<>();
+}
@@ -7,10 +7,16 @@
  */
 
 #include <seastar/testing/thread_test_case.hh>
+#include <seastar/testing/test_case.hh>
 
 #include "transport/request.hh"
 #include "transport/response.hh"
+#include "transport/server.hh"
+#include "tracing/tracing.hh"
+#include "tracing/trace_state.hh"
+#include "tracing/tracing_backend_registry.hh"
 
+#include "test/lib/cql_test_env.hh"
 #include "test/lib/random_utils.hh"
 
 namespace cql3 {
@@ -152,3 +158,122 @@ SEASTAR_THREAD_TEST_CASE(test_response_request_reader) {
     BOOST_CHECK_EQUAL(req.read_short(), 1);
     BOOST_CHECK_EQUAL(req.read_string(), "zed");
 }
+
+// The custom payload goes after the tracing session id and the warnings,
+// even though it is set after the body is written.
+SEASTAR_TEST_CASE(test_response_custom_payload) {
+    return do_with_cql_env_thread([] (cql_test_env& e) {
+        tracing::backend_registry tracing_backend_registry;
+        tracing::register_tracing_keyspace_backend(tracing_backend_registry);
+        tracing::tracing::create_tracing(tracing_backend_registry, "trace_keyspace_helper").get();
+        tracing::tracing::start_tracing(e.qp()).get();
+        auto stop_tracing = [] {
+            tracing::tracing::tracing_instance().invoke_on_all([] (tracing::tracing& local_tracing) {
+                return local_tracing.shutdown();
+            }).get();
+            tracing::tracing::tracing_instance().stop().get();
+        };
+      try {
+        tracing::trace_state_props_set trace_props;
+        trace_props.set(tracing::trace_state_props::full_tracing);
+        trace_props.set(tracing::trace_state_props::write_on_close);
+        auto trace_state = tracing::tracing::get_local_tracing_instance().create_session(tracing::trace_type::QUERY, trace_props);
+        BOOST_REQUIRE(tracing::should_return_id_in_response(trace_state));
+
+        auto stream_id = tests::random::get_int<int16_t>();
+        auto res = cql_transport::response(stream_id, cql_transport::cql_binary_opcode::RESULT, trace_state);
+        auto warnings = std::vector<sstring>{"warning 1", "warning 2"};
+        res.write_warnings(warnings);
+        // Large enough to span several fragments.
+        auto value = tests::random::get_bytes(256 * 1024);
+        res.write_int(42);
+        res.write_value(bytes_opt(value));
+
+        auto payload = std::map<sstring, bytes>{
+            {"key1", tests::random::get_bytes(16)},
+            {"key2", bytes()},
+        };
+        res.set_custom_payload(payload);
+
+        static constexpr auto version = 4;
+        auto msg = res.make_message(version, cql_transport::cql_compression::none).release();
+        auto total_length = msg.len();
+        auto fbufs = fragmented_temporary_buffer(msg.release(), total_length);
+
+        bytes_ostream linearization_buffer;
+        auto req = cql_transport::request_reader(fbufs.get_istream(), linearization_buffer);
+        BOOST_CHECK_EQUAL(unsigned(uint8_t(req.read_byte())), version | 0x80);
+        BOOST_CHECK_EQUAL(unsigned(req.read_byte()), unsigned(cql_transport::cql_frame_flags::tracing
+                | cql_transport::cql_frame_flags::warning | cql_transport::cql_frame_flags::custom_payload));
+        BOOST_CHECK_EQUAL(req.read_short(), stream_id);
+        BOOST_CHECK_EQUAL(unsigned(req.read_byte()), unsigned(cql_transport::cql_binary_opcode::RESULT));
+        BOOST_CHECK_EQUAL(req.read_int() + 9, total_length);
+
+        auto msb = req.read_long();
+        auto lsb = req.read_long();
+        BOOST_CHECK_EQUAL(utils::UUID(msb, lsb), trace_state->session_id());
+
+        auto received_warnings = std::vector<sstring>();
+        req.read_string_list(received_warnings);
+        BOOST_CHECK_EQUAL(received_warnings, warnings);
+
+        auto received_payload = std::map<sstring, bytes>();
+        auto payload_size = req.read_short();
+        for (uint16_t i = 0; i < payload_size; ++i) {
+            auto key = req.read_string();
+            received_payload.emplace(std::move(key), *req.read_bytes());
+        }
+        BOOST_CHECK(received_payload == payload);
+
+        BOOST_CHECK_EQUAL(req.read_int(), 42);
+        BOOST_CHECK_EQUAL(to_bytes(req.read_value_view(version)), value);
+        BOOST_CHECK_EQUAL(req.bytes_left(), 0u);
+      } catch (...) {
+        stop_tracing();
+        throw;
+      }
+        stop_tracing();
+    });
+}
+
+// A bounced request's response is owned by the shard which executed it, so
+// that shard has to add the shard hint, which names it.
+SEASTAR_THREAD_TEST_CASE(test_shard_hint_is_added_by_response_owner) {
+    cql_transport::cql_server_config config{};
+    config.shard_aware_transport_port = 19042;
+    auto owner = smp::count - 1;
+    smp::submit_to(owner, [&config] {
+        using cql_transport::cql_server;
+        cql_server::result_with_foreign_response_ptr res = make_foreign(std::make_unique<cql_server::response>(
+                int16_t(1), cql_transport::cql_binary_opcode::RESULT, tracing::trace_state_ptr()));
+        res.value()->write_int(42);
+        cql_server::add_shard_hint(res, config);
+
+        static constexpr auto version = 4;
+        auto msg = res.value()->make_message(version, cql_transport::cql_compression::none).release();
+        auto total_length = msg.len();
+        auto fbufs = fragmented_temporary_buffer(msg.release(), total_length);
+
+        bytes_ostream linearization_buffer;
+        auto req = cql_transport::request_reader(fbufs.get_istream(), linearization_buffer);
+        req.read_byte();
+        BOOST_CHECK_EQUAL(unsigned(req.read_byte()), unsigned(cql_transport::cql_frame_flags::custom_payload));
+        req.read_short();
+        req.read_byte();
+        req.read_int();
+
+        auto received_payload = std::map<sstring, sstring>();
+        auto payload_size = req.read_short();
+        for (uint16_t i = 0; i < payload_size; ++i) {
+            auto key = req.read_string();
+            auto value = *req.read_bytes();
+            received_payload.emplace(std::move(key), sstring(reinterpret_cast<const char*>(value.data()), value.size()));
+        }
+        auto expected_payload = std::map<sstring, sstring>{
+            {"SCYLLA_SHARD", format("{}", this_shard_id())},
+            {"SCYLLA_SHARD_AWARE_PORT", "19042"},
+        };
+        BOOST_CHECK(received_payload == expected_payload);
+        BOOST_CHECK_EQUAL(req.read_int(), 42);
+    }).get();
+}
@@ -19,6 +19,19 @@ def test_snapshots_table(scylla_only, cql, test_keyspace):
         assert res[0][1] == tbl
         assert res[0][2] == 'my_tag'
 
+def test_hot_partitions_table(scylla_only, cql, test_keyspace):
+    with util.new_test_table(cql, test_keyspace, 'pk int PRIMARY KEY, v int') as table:
+        stmt = cql.prepare(f"INSERT INTO {table} (pk, v) VALUES (?, ?)")
+        for i in range(1000):
+            cql.execute(stmt, [7, i])
+        ks, tbl = table.split('.')
+        res = list(cql.execute(f"SELECT table_name, operation, partition_key, count FROM system.hot_partitions WHERE keyspace_name = '{ks}'"))
+        writes = [r for r in res if r.table_name == tbl and r.operation == 'write']
+        # Writes are sampled, but a partition written this often must be found.
+        assert len(writes) == 1
+        assert '7' in writes[0].partition_key
+        assert writes[0].count > 0
+
 def test_clients(scylla_only, cql):
     columns = ', '.join([
         'address',
@@ -52,6 +65,9 @@ def test_protocol_servers(scylla_only, cql):
 def test_runtime_info(scylla_only, cql):
     _check_exists(cql, "runtime_info", ("group", "item", "value"))
 
+def test_stage_latencies(scylla_only, cql):
+    _check_exists(cql, "stage_latencies", ("stage", "shard", "count", "mean_us", "p50_us", "p90_us", "p99_us", "p999_us", "max_us"))
+
 def test_versions(scylla_only, cql):
     _check_exists(cql, "versions", ("key", "build_id", "build_mode", "version"))
 
@@ -135,6 +135,7 @@ class single_node_cql_env : public cql_test_env {
     sharded<db::batchlog_manager>& _batchlog_manager;
     sharded<gms::gossiper>& _gossiper;
     service::raft_group0_client& _group0_client;
+    sharded<db::system_keyspace>& _sys_ks;
 
 private:
     struct core_local_state {
@@ -186,7 +187,8 @@ class single_node_cql_env : public cql_test_env {
             sharded<qos::service_level_controller> &sl_controller,
             sharded<db::batchlog_manager>& batchlog_manager,
             sharded<gms::gossiper>& gossiper,
-            service::raft_group0_client& client)
+            service::raft_group0_client& client,
+            sharded<db::system_keyspace>& sys_ks)
             : _db(db)
             , _qp(qp)
             , _auth_service(auth_service)
@@ -198,6 +200,7 @@ class single_node_cql_env : public cql_test_env {
             , _batchlog_manager(batchlog_manager)
             , _gossiper(gossiper)
             , _group0_client(client)
+            , _sys_ks(sys_ks)
     {
         adjust_rlimit();
     }
@@ -417,6 +420,10 @@ class single_node_cql_env : public cql_test_env {
         return _group0_client;
     }
 
+    virtual sharded<db::system_keyspace>& get_system_keyspace() override {
+        return _sys_ks;
+    }
+
     virtual future<> refresh_client_state() override {
         return _core_local.invoke_on_all([] (core_local_state& state) {
             return state.client_state.maybe_update_per_service_level_params();
@@ -855,7 +862,7 @@ class single_node_cql_env : public cql_test_env {
                 // The default user may already exist if this `cql_test_env` is starting with previously populated data.
             }
 
-            single_node_cql_env env(db, qp, auth_service, view_builder, view_update_generator, mm_notif, mm, std::ref(sl_controller), bm, gossiper, group0_client);
+            single_node_cql_env env(db, qp, auth_service, view_builder, view_update_generator, mm_notif, mm, std::ref(sl_controller), bm, gossiper, group0_client, sys_ks);
             env.start().get();
             auto stop_env = defer([&env] { env.stop().get(); });
 
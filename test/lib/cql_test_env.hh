@@ -32,6 +32,7 @@ class database;
 
 namespace db {
 class batchlog_manager;
+class system_keyspace;
 }
 
 namespace db::view {
@@ -166,6 +167,8 @@ class cql_test_env {
 
     virtual service::raft_group0_client& get_raft_group0_client() = 0;
 
+    virtual sharded<db::system_keyspace>& get_system_keyspace() = 0;
+
     data_dictionary::database data_dictionary();
 };
 
@@ -220,6 +220,89 @@ void test_scan_with_range_delete_over_rows() {
     tracker.cleaner().drain().get();
 }
 
+// Measures the throughput of single-partition reads which hit in cache.
+void test_cache_hit_reads() {
+    std::cout << __FUNCTION__<< std::endl;
+
+    simple_schema ss;
+    auto s = ss.schema();
+    tests::reader_concurrency_semaphore_wrapper semaphore;
+
+    cache_tracker tracker;
+    memtable_snapshot_source mss(s);
+
+    auto val = sstring(sstring::initialized_later(), cell_size);
+    const size_t rows_per_partition = 8;
+
+    std::cout << "Populating with partitions" << std::endl;
+
+    const size_t cache_size = seastar::memory::stats().total_memory() / 4;
+    std::vector<dht::decorated_key> keys;
+    while (mss.used_space() < cache_size) {
+        auto pk = ss.make_pkey(keys.size());
+        mutation m(s, pk);
+        for (size_t i = 0; i < rows_per_partition; ++i) {
+            ss.add_row(m, ss.make_ckey(i), val);
+        }
+        mss.apply(m);
+        keys.push_back(std::move(pk));
+
+        if (cancelled) {
+            return;
+        }
+    }
+
+    row_cache cache(s, snapshot_source([&] { return mss(); }), tracker, is_continuous::no);
+
+    // Populate the cache with a full scan, so that all reads below hit.
+    {
+        auto rd = cache.make_reader(s, semaphore.make_permit(), query::full_partition_range);
+        auto close_reader = deferred_close(rd);
+        rd.consume_pausable([](mutation_fragment_v2) {
+            return stop_iteration(cancelled);
+        }).get();
+    }
+
+    std::cout << "Partitions: " << keys.size() << ", rows in cache: " << tracker.get_stats().rows << std::endl;
+    std::cout << "Reading..." << std::endl;
+
+    auto test_read = [&] {
+        const size_t max_reads = 100000;
+        size_t reads = 0;
+        size_t fragments = 0;
+        auto d = duration_in_seconds([&] {
+            for (; reads < max_reads && !cancelled; ++reads) {
+                auto pr = dht::partition_range::make_singular(keys[tests::random::get_int<size_t>(0, keys.size() - 1)]);
+                auto rd = cache.make_reader(s, semaphore.make_permit(), pr);
+                auto close_reader = deferred_close(rd);
+                rd.consume_pausable([&fragments](mutation_fragment_v2) {
+                    ++fragments;
+                    return stop_iteration::no;
+                }).get();
+                seastar::thread::maybe_yield();
+            }
+        });
+
+        // Rates are computed only over the reads which completed, if the run was cancelled.
+        if (!reads || d.count() <= 0) {
+            return;
+        }
+        std::cout << format("read: {:.6f} [ms], {:.0f} [reads/s], {:.0f} [frag/s], cache: {:d}/{:d} [MB]\n",
+                            d.count() * 1000,
+                            reads / d.count(),
+                            fragments / d.count(),
+                            tracker.region().occupancy().used_space() / MB,
+                            tracker.region().occupancy().total_space() / MB);
+    };
+
+    test_read();
+    test_read();
+
+    // Clean gently to avoid reactor stalls in destructors
+    cache.invalidate(row_cache::external_updater([]{})).get();
+    tracker.cleaner().drain().get();
+}
+
 int main(int argc, char** argv) {
     app_template app;
     return app.run(argc, argv, [&app] {
@@ -231,6 +314,7 @@ int main(int argc, char** argv) {
             logalloc::prime_segment_pool(memory::stats().total_memory(), memory::min_free_memory()).get();
             test_scans_with_dummy_entries();
             test_scan_with_range_delete_over_rows();
+            test_cache_hit_reads();
         });
     });
 }
@@ -2318,3 +2318,47 @@ BOOST_AUTO_TEST_CASE(test_ping_leader) {
     communicate(A, B, C);
     BOOST_CHECK(C.current_leader());
 }
+
+BOOST_AUTO_TEST_CASE(test_pipeline_window) {
+    // Check that a leader doesn't have more than
+    // max_append_requests_in_flight un-acked append requests
+    // to a follower in PIPELINE mode.
+    server_id A_id = id(), B_id = id();
+    raft::log log_A(raft::snapshot_descriptor{.idx = index_t{0}, .config = config_from_ids({A_id, B_id})});
+    raft::log log_B(raft::snapshot_descriptor{.idx = index_t{0}, .config = config_from_ids({A_id, B_id})});
+    auto cfg = fsm_cfg;
+    cfg.max_append_requests_in_flight = 2;
+    fsm_debug A(A_id, term_t{}, server_id{}, std::move(log_A), trivial_failure_detector, cfg);
+    fsm_debug B(B_id, term_t{}, server_id{}, std::move(log_B), trivial_failure_detector, cfg);
+    election_timeout(A);
+    communicate(A, B);
+    BOOST_CHECK(A.is_leader());
+    A.add_entry(log_entry::dummy{});
+    A.tick();
+    communicate(A, B);
+    BOOST_CHECK(A.get_progress(B_id).state == raft::follower_progress::state::PIPELINE);
+
+    for (int i = 0; i < 5; i++) {
+        A.add_entry(log_entry::dummy{});
+    }
+    // fsm_cfg sends one entry per request
+    auto output = A.get_output();
+    size_t append_requests = 0;
+    for (auto& [to, m] : output.messages) {
+        if (to == B_id && std::holds_alternative<raft::append_request>(m)) {
+            append_requests++;
+        }
+    }
+    BOOST_CHECK_EQUAL(append_requests, 2);
+    BOOST_CHECK_EQUAL(A.get_progress(B_id).in_flight, 2);
+}
+
+BOOST_AUTO_TEST_CASE(test_pipeline_window_zero) {
+    // A zero window would never let the leader send anything
+    // to a follower in PIPELINE mode, reject it.
+    server_id A_id = id();
+    raft::log log_A(raft::snapshot_descriptor{.idx = index_t{0}, .config = config_from_ids({A_id})});
+    auto cfg = fsm_cfg;
+    cfg.max_append_requests_in_flight = 0;
+    BOOST_CHECK_THROW(fsm_debug(A_id, term_t{}, server_id{}, std::move(log_A), trivial_failure_detector, cfg), std::invalid_argument);
+}
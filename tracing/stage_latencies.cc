@@ -0,0 +1,41 @@
+/*
+ * Copyright (C) 2022-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#include "tracing/stage_latencies.hh"
+
+namespace tracing {
+
+static constexpr std::array<std::string_view, stage_count> stage_names = {
+    "cql_parse",
+    "coordinator_read",
+    "coordinator_write",
+    "replica_queue_wait",
+    "replica_read",
+    "cql_response_write",
+};
+
+std::string_view stage_name(stage s) noexcept {
+    return stage_names[size_t(s)];
+}
+
+std::optional<stage> stage_from_name(std::string_view name) noexcept {
+    for (size_t i = 0; i < stage_count; ++i) {
+        if (stage_names[i] == name) {
+            return stage(i);
+        }
+    }
+    return std::nullopt;
+}
+
+static thread_local stage_latencies the_stage_latencies;
+
+stage_latencies& local_stage_latencies() noexcept {
+    return the_stage_latencies;
+}
+
+} // namespace tracing
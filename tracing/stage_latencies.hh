@@ -0,0 +1,112 @@
+/*
+ * Copyright (C) 2022-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <optional>
+#include <string_view>
+#include <type_traits>
+
+#include <seastar/core/future.hh>
+
+#include "seastarx.hh"
+#include "utils/estimated_histogram.hh"
+
+namespace tracing {
+
+// Stages of a request whose latency is sampled into per-shard histograms.
+//
+// Unlike full tracing, sampling does not create a tracing session nor write
+// anything to system_traces, so it is cheap enough to stay enabled all the
+// time. Stages are sampled independently of each other, so the histograms
+// describe the latency distribution of every stage, not of individual requests.
+enum class stage : uint8_t {
+    cql_parse,           // parsing a CQL statement
+    coordinator_read,    // a read, as seen by the coordinator
+    coordinator_write,   // a write, as seen by the coordinator
+    replica_queue_wait,  // waiting in the reader concurrency semaphore queue, for reads which are not admitted immediately
+    replica_read,        // reading from the cache and sstables, once admitted
+    cql_response_write,  // writing a CQL response to the client socket
+};
+
+constexpr size_t stage_count = size_t(stage::cql_response_write) + 1;
+
+std::string_view stage_name(stage s) noexcept;
+std::optional<stage> stage_from_name(std::string_view name) noexcept;
+
+// Covers 4us to 33s, parsing latencies are much lower than the 512us lower
+// bound of utils::time_estimated_histogram.
+using stage_latency_histogram = utils::approx_exponential_histogram<4, 33554432, 4>;
+
+class stage_latencies {
+public:
+    using clock = std::chrono::steady_clock;
+    // One in every default_sampling_period occurrences of every stage is sampled.
+    static constexpr uint32_t default_sampling_period = 100;
+private:
+    std::array<stage_latency_histogram, stage_count> _histograms;
+    std::array<uint32_t, stage_count> _countdown{};
+    uint32_t _sampling_period = default_sampling_period;
+public:
+    // Returns the start time of the stage if this occurrence is sampled.
+    std::optional<clock::time_point> maybe_start(stage s) noexcept {
+        auto& countdown = _countdown[size_t(s)];
+        if (countdown > 1) {
+            --countdown;
+            return std::nullopt;
+        }
+        countdown = _sampling_period;
+        if (!_sampling_period) {
+            return std::nullopt;
+        }
+        return clock::now();
+    }
+
+    void finish(stage s, std::optional<clock::time_point> start) noexcept {
+        if (start) {
+            record(s, clock::now() - *start);
+        }
+    }
+
+    void record(stage s, clock::duration latency) noexcept {
+        _histograms[size_t(s)].add(std::chrono::duration_cast<std::chrono::microseconds>(latency).count());
+    }
+
+    const stage_latency_histogram& histogram(stage s) const noexcept {
+        return _histograms[size_t(s)];
+    }
+
+    // 0 disables sampling, 1 samples every occurrence.
+    void set_sampling_period(uint32_t period) noexcept {
+        _sampling_period = period;
+        _countdown.fill(0);
+    }
+
+    uint32_t sampling_period() const noexcept {
+        return _sampling_period;
+    }
+};
+
+stage_latencies& local_stage_latencies() noexcept;
+
+// Invokes func() and, if this occurrence of the stage is sampled, records
+// the time it took for the returned future to resolve.
+template <typename Func>
+futurize_t<std::invoke_result_t<Func>> sample_stage(stage s, Func&& func) {
+    auto start = local_stage_latencies().maybe_start(s);
+    if (!start) {
+        return futurize_invoke(std::forward<Func>(func));
+    }
+    return futurize_invoke(std::forward<Func>(func)).finally([s, start] {
+        local_stage_latencies().finish(s, start);
+    });
+}
+
+} // namespace tracing
@@ -17,7 +17,8 @@ namespace cql_transport {
 
 static const std::map<cql_protocol_extension, seastar::sstring> EXTENSION_NAMES = {
     {cql_protocol_extension::LWT_ADD_METADATA_MARK, "SCYLLA_LWT_ADD_METADATA_MARK"},
-    {cql_protocol_extension::RATE_LIMIT_ERROR, "SCYLLA_RATE_LIMIT_ERROR"}
+    {cql_protocol_extension::RATE_LIMIT_ERROR, "SCYLLA_RATE_LIMIT_ERROR"},
+    {cql_protocol_extension::SHARD_HINT, "SCYLLA_SHARD_HINT"}
 };
 
 cql_protocol_extension_enum_set supported_cql_protocol_extensions() {
@@ -29,12 +29,14 @@ namespace cql_transport {
  */
 enum class cql_protocol_extension {
     LWT_ADD_METADATA_MARK,
-    RATE_LIMIT_ERROR
+    RATE_LIMIT_ERROR,
+    SHARD_HINT
 };
 
 using cql_protocol_extension_enum = super_enum<cql_protocol_extension,
     cql_protocol_extension::LWT_ADD_METADATA_MARK,
-    cql_protocol_extension::RATE_LIMIT_ERROR>;
+    cql_protocol_extension::RATE_LIMIT_ERROR,
+    cql_protocol_extension::SHARD_HINT>;
 
 using cql_protocol_extension_enum_set = enum_set<cql_protocol_extension_enum>;
 
@@ -38,6 +38,9 @@ class response {
     cql_binary_opcode _opcode;
     uint8_t           _flags = 0; // a bitwise OR mask of zero or more cql_frame_flags values
     bytes_ostream _body;
+    // Offset in _body at which a custom payload goes, i.e. past the
+    // tracing session id and warnings.
+    size_t _custom_payload_pos = 0;
 public:
     template<typename T>
     class placeholder;
@@ -51,6 +54,7 @@ class response {
             tr_state_ptr->session_id().serialize(i);
             set_frame_flag(cql_frame_flags::tracing);
         }
+        _custom_payload_pos = _body.size();
     }
 
     void set_frame_flag(cql_frame_flags flag) noexcept {
@@ -58,6 +62,11 @@ class response {
     }
 
     void serialize(const event::schema_change& event, uint8_t version);
+    void write_warnings(std::vector<sstring> warnings);
+    // Inserts a custom payload (protocol v4 and later) in front of the
+    // message body. May be called after the body has been written, but
+    // must be called at most once and before make_message().
+    void set_custom_payload(const std::map<sstring, bytes>& payload);
     void write_byte(uint8_t b);
     void write_int(int32_t n);
     placeholder<int32_t> write_int_placeholder();
@@ -35,6 +35,7 @@
 #include <seastar/net/byteorder.hh>
 #include <seastar/util/lazy.hh>
 #include <seastar/core/execution_stage.hh>
+#include <seastar/core/on_internal_error.hh>
 #include "utils/result_try.hh"
 #include "utils/result_combinators.hh"
 #include "db/operation_type.hh"
@@ -61,6 +62,7 @@
 #include "transport/cql_protocol_extension.hh"
 #include "utils/bit_cast.hh"
 #include "db/config.hh"
+#include "tracing/stage_latencies.hh"
 
 template<typename T = void>
 using coordinator_result = exceptions::coordinator_result<T>;
@@ -835,12 +837,36 @@ std::unique_ptr<cql_server::response>
 make_result(int16_t stream, messages::result_message& msg, const tracing::trace_state_ptr& tr_state,
         cql_protocol_version_type version, bool skip_metadata = false);
 
+void cql_server::add_shard_hint(result_with_foreign_response_ptr& res, const cql_server_config& config) {
+    if (!res) {
+        return;
+    }
+    if (res.value().get_owner_shard() != this_shard_id()) {
+        on_internal_error(clogger, format("Adding a shard hint on shard {} to a response owned by shard {}", this_shard_id(), res.value().get_owner_shard()));
+    }
+    auto to_value = [] (unsigned v) {
+        auto s = format("{:d}", v);
+        return bytes(reinterpret_cast<const int8_t*>(s.data()), s.size());
+    };
+    std::map<sstring, bytes> hint;
+    hint.emplace("SCYLLA_SHARD", to_value(this_shard_id()));
+    if (config.shard_aware_transport_port) {
+        hint.emplace("SCYLLA_SHARD_AWARE_PORT", to_value(*config.shard_aware_transport_port));
+    }
+    if (config.shard_aware_transport_port_ssl) {
+        hint.emplace("SCYLLA_SHARD_AWARE_PORT_SSL", to_value(*config.shard_aware_transport_port_ssl));
+    }
+    res.value()->set_custom_payload(hint);
+}
+
 template<typename Process>
 future<cql_server::result_with_foreign_response_ptr>
 cql_server::connection::process_on_shard(::shared_ptr<messages::result_message::bounce_to_shard> bounce_msg, uint16_t stream, fragmented_temporary_buffer::istream is,
         service::client_state& cs, service_permit permit, tracing::trace_state_ptr trace_state, Process process_fn) {
-    return _server.container().invoke_on(*bounce_msg->move_to_shard(), _server._config.bounce_request_smp_service_group,
-            [this, is = std::move(is), cs = cs.move_to_other_shard(), stream, permit = std::move(permit), process_fn,
+    auto shard = *bounce_msg->move_to_shard();
+    bool shard_hint = _version >= 4 && _client_state.is_protocol_extension_set(cql_protocol_extension::SHARD_HINT);
+    return _server.container().invoke_on(shard, _server._config.bounce_request_smp_service_group,
+            [this, is = std::move(is), cs = cs.move_to_other_shard(), stream, permit = std::move(permit), process_fn, shard_hint,
              gt = tracing::global_trace_state_ptr(std::move(trace_state)),
              cached_vals = std::move(bounce_msg->take_cached_pk_function_calls())] (cql_server& server) {
         service::client_state client_state = cs.get();
@@ -851,9 +877,14 @@ cql_server::connection::process_on_shard(::shared_ptr<messages::result_message::
                     cql3::computed_function_values& cached_vals) mutable {
             request_reader in(is, linearization_buffer);
             return process_fn(client_state, server._query_processor, in, stream, _version, _cql_serialization_format,
-                    /* FIXME */empty_service_permit(), std::move(trace_state), false, std::move(cached_vals)).then([] (auto msg) {
+                    /* FIXME */empty_service_permit(), std::move(trace_state), false, std::move(cached_vals)).then([&server, shard_hint] (auto msg) {
                 // result here has to be foreign ptr
-                return std::get<cql_server::result_with_foreign_response_ptr>(std::move(msg));
+                auto res = std::get<cql_server::result_with_foreign_response_ptr>(std::move(msg));
+                if (shard_hint) {
+                    // The response is owned by this shard, so it has to be modified here.
+                    add_shard_hint(res, server._config);
+                }
+                return res;
             });
         });
     });
@@ -937,31 +968,24 @@ future<std::unique_ptr<cql_server::response>> cql_server::connection::process_pr
     tracing::add_query(trace_state, query);
     tracing::begin(trace_state, "Preparing CQL3 query", client_state.get_client_address());
 
-    auto cpu_id = this_shard_id();
-    auto cpus = boost::irange(0u, smp::count);
-    return parallel_for_each(cpus.begin(), cpus.end(), [this, query, cpu_id, &client_state] (unsigned int c) mutable {
-        if (c != cpu_id) {
-            return smp::submit_to(c, [this, query, &client_state] () mutable {
-                return _server._query_processor.local().prepare(std::move(query), client_state, false).discard_result();
-            });
-        } else {
-            return make_ready_future<>();
-        }
-    }).then([this, query, stream, &client_state, trace_state] () mutable {
-        tracing::trace(trace_state, "Done preparing on remote shards");
-        return _server._query_processor.local().prepare(std::move(query), client_state, false).then([this, stream, &client_state, trace_state] (auto msg) {
-            tracing::trace(trace_state, "Done preparing on a local shard - preparing a result. ID is [{}]", seastar::value_of([&msg] {
-                return messages::result_message::prepared::cql::get_id(msg);
-            }));
+    // Other shards prepare the statement on first use, from the node-wide index.
+    return _server._query_processor.local().prepare(query, client_state, false).then([this, query, stream, &client_state, trace_state] (auto msg) mutable {
+        tracing::trace(trace_state, "Done preparing on a local shard. ID is [{}]", seastar::value_of([&msg] {
+            return messages::result_message::prepared::cql::get_id(msg);
+        }));
+        return _server._query_processor.local().index_prepared_statement(std::move(query), client_state.get_raw_keyspace()).then([this, stream, trace_state, msg] {
+            tracing::trace(trace_state, "Done indexing the prepared statement - preparing a result");
             return make_result(stream, *msg, trace_state, _version);
         });
     });
 }
 
 static future<process_fn_return_type>
-process_execute_internal(service::client_state& client_state, distributed<cql3::query_processor>& qp, request_reader in,
+do_process_execute(service::client_state& client_state, distributed<cql3::query_processor>& qp, request_reader in,
         uint16_t stream, cql_protocol_version_type version, cql_serialization_format serialization_format,
-        service_permit permit, tracing::trace_state_ptr trace_state, bool init_trace, cql3::computed_function_values cached_pk_fn_calls) {
+        service_permit permit, tracing::trace_state_ptr trace_state, bool init_trace, cql3::computed_function_values cached_pk_fn_calls,
+        bool prepare_if_missing) {
+    const auto original_in = in;
     cql3::prepared_cache_key_type cache_key(in.read_short_bytes());
     auto& id = cql3::prepared_cache_key_type::cql_id(cache_key);
     bool needs_authorization = false;
@@ -975,7 +999,19 @@ process_execute_internal(service::client_state& client_state, distributed<cql3::
     }
 
     if (!prepared) {
-        throw exceptions::prepared_query_not_found_exception(id);
+        if (!prepare_if_missing) {
+            throw exceptions::prepared_query_not_found_exception(id);
+        }
+        // The statement may have been prepared on another shard only.
+        return qp.local().prepare_from_index(cache_key).then([&client_state, &qp, original_in, stream, version, serialization_format,
+                permit = std::move(permit), trace_state = std::move(trace_state), init_trace, cached_pk_fn_calls = std::move(cached_pk_fn_calls),
+                cache_key] (bool found) mutable {
+            if (!found) {
+                throw exceptions::prepared_query_not_found_exception(cql3::prepared_cache_key_type::cql_id(cache_key));
+            }
+            return do_process_execute(client_state, qp, original_in, stream, version, serialization_format, std::move(permit),
+                    std::move(trace_state), init_trace, std::move(cached_pk_fn_calls), false);
+        });
     }
 
     auto q_state = std::make_unique<cql_query_state>(client_state, trace_state, std::move(permit));
@@ -1036,6 +1072,14 @@ process_execute_internal(service::client_state& client_state, distributed<cql3::
     });
 }
 
+static future<process_fn_return_type>
+process_execute_internal(service::client_state& client_state, distributed<cql3::query_processor>& qp, request_reader in,
+        uint16_t stream, cql_protocol_version_type version, cql_serialization_format serialization_format,
+        service_permit permit, tracing::trace_state_ptr trace_state, bool init_trace, cql3::computed_function_values cached_pk_fn_calls) {
+    return do_process_execute(client_state, qp, std::move(in), stream, version, serialization_format, std::move(permit),
+            std::move(trace_state), init_trace, std::move(cached_pk_fn_calls), true);
+}
+
 future<cql_server::result_with_foreign_response_ptr> cql_server::connection::process_execute(uint16_t stream, request_reader in,
         service::client_state& client_state, service_permit permit, tracing::trace_state_ptr trace_state) {
     ++_server._stats.execute_requests;
@@ -1043,13 +1087,9 @@ future<cql_server::result_with_foreign_response_ptr> cql_server::connection::pro
 }
 
 static future<process_fn_return_type>
-process_batch_internal(service::client_state& client_state, distributed<cql3::query_processor>& qp, request_reader in,
+do_process_batch(service::client_state& client_state, distributed<cql3::query_processor>& qp, request_reader in,
         uint16_t stream, cql_protocol_version_type version, cql_serialization_format serialization_format,
         service_permit permit, tracing::trace_state_ptr trace_state, bool init_trace, cql3::computed_function_values cached_pk_fn_calls) {
-    if (version == 1) {
-        throw exceptions::protocol_exception("BATCH messages are not support in version 1 of the protocol");
-    }
-
     const auto type = in.read_byte();
     const unsigned n = in.read_short();
 
@@ -1161,6 +1201,56 @@ process_batch_internal(service::client_state& client_state, distributed<cql3::qu
     });
 }
 
+// Returns the prepared statements referenced by a batch which are not prepared on this shard.
+static std::vector<cql3::prepared_cache_key_type>
+missing_batch_statements(cql3::query_processor& qp, request_reader in, cql_protocol_version_type version) {
+    std::vector<cql3::prepared_cache_key_type> missing;
+    in.read_byte(); // type
+    const unsigned n = in.read_short();
+    for ([[gnu::unused]] auto i : boost::irange(0u, n)) {
+        const auto kind = in.read_byte();
+        if (kind == 0) {
+            in.read_long_string_view();
+        } else if (kind == 1) {
+            cql3::prepared_cache_key_type cache_key(in.read_short_bytes());
+            if (!qp.get_prepared(cache_key)) {
+                missing.push_back(std::move(cache_key));
+            }
+        } else {
+            // Let do_process_batch() report the error.
+            break;
+        }
+        std::vector<cql3::raw_value_view> tmp;
+        in.read_value_view_list(version, tmp);
+    }
+    return missing;
+}
+
+static future<process_fn_return_type>
+process_batch_internal(service::client_state& client_state, distributed<cql3::query_processor>& qp, request_reader in,
+        uint16_t stream, cql_protocol_version_type version, cql_serialization_format serialization_format,
+        service_permit permit, tracing::trace_state_ptr trace_state, bool init_trace, cql3::computed_function_values cached_pk_fn_calls) {
+    if (version == 1) {
+        throw exceptions::protocol_exception("BATCH messages are not support in version 1 of the protocol");
+    }
+    auto missing = missing_batch_statements(qp.local(), in, version);
+    if (missing.empty()) {
+        return do_process_batch(client_state, qp, std::move(in), stream, version, serialization_format, std::move(permit),
+                std::move(trace_state), init_trace, std::move(cached_pk_fn_calls));
+    }
+    // Statements prepared on other shards only are prepared here from the node-wide index.
+    // Those which are not known to the node are reported by do_process_batch().
+    return do_with(std::move(missing), [&qp] (std::vector<cql3::prepared_cache_key_type>& missing) {
+        return parallel_for_each(missing, [&qp] (const cql3::prepared_cache_key_type& key) {
+            return qp.local().prepare_from_index(key).discard_result();
+        });
+    }).then([&client_state, &qp, in = std::move(in), stream, version, serialization_format, permit = std::move(permit),
+            trace_state = std::move(trace_state), init_trace, cached_pk_fn_calls = std::move(cached_pk_fn_calls)] () mutable {
+        return do_process_batch(client_state, qp, std::move(in), stream, version, serialization_format, std::move(permit),
+                std::move(trace_state), init_trace, std::move(cached_pk_fn_calls));
+    });
+}
+
 future<cql_server::result_with_foreign_response_ptr>
 cql_server::connection::process_batch(uint16_t stream, request_reader in, service::client_state& client_state, service_permit permit,
         tracing::trace_state_ptr trace_state) {
@@ -1438,8 +1528,7 @@ make_result(int16_t stream, messages::result_message& msg, const tracing::trace_
         cql_protocol_version_type version, bool skip_metadata) {
     auto response = std::make_unique<cql_server::response>(stream, cql_binary_opcode::RESULT, tr_state);
     if (__builtin_expect(!msg.warnings().empty() && version > 3, false)) {
-        response->set_frame_flag(cql_frame_flags::warning);
-        response->write_string_list(msg.warnings());
+        response->write_warnings(msg.warnings());
     }
     cql_server::fmt_visitor fmt{version, *response, skip_metadata};
     msg.accept(fmt);
@@ -1477,6 +1566,8 @@ cql_server::connection::make_schema_change_event(const event::schema_change& eve
 
 void cql_server::connection::write_response(foreign_ptr<std::unique_ptr<cql_server::response>>&& response, service_permit permit, cql_compression compression)
 {
+    // The sampled time includes waiting for the preceding responses to be written.
+    auto start = tracing::local_stage_latencies().maybe_start(tracing::stage::cql_response_write);
     _ready_to_respond = _ready_to_respond.then([this, compression, response = std::move(response), permit = std::move(permit)] () mutable {
         auto message = response->make_message(_version, compression);
         message.on_delete([response = std::move(response)] { });
@@ -1484,6 +1575,11 @@ void cql_server::connection::write_response(foreign_ptr<std::unique_ptr<cql_serv
             return _write_buf.flush();
         });
     });
+    if (start) {
+        _ready_to_respond = _ready_to_respond.finally([start] {
+            tracing::local_stage_latencies().finish(tracing::stage::cql_response_write, start);
+        });
+    }
 }
 
 scattered_message<char> cql_server::response::make_message(uint8_t version, cql_compression compression) {
@@ -1671,6 +1767,42 @@ void cql_server::response::write_string_list(std::vector<sstring> string_list)
     }
 }
 
+void cql_server::response::write_warnings(std::vector<sstring> warnings)
+{
+    set_frame_flag(cql_frame_flags::warning);
+    write_string_list(std::move(warnings));
+    _custom_payload_pos = _body.size();
+}
+
+void cql_server::response::set_custom_payload(const std::map<sstring, bytes>& payload)
+{
+    auto write_payload = [&] {
+        write_short(payload.size());
+        for (auto& [key, value] : payload) {
+            write_string(key);
+            write_bytes(value);
+        }
+    };
+    auto body = std::exchange(_body, bytes_ostream());
+    size_t prefix_left = _custom_payload_pos;
+    bool payload_written = false;
+    for (bytes_view fragment : body.fragments()) {
+        if (!payload_written && fragment.size() >= prefix_left) {
+            _body.write(fragment.substr(0, prefix_left));
+            write_payload();
+            payload_written = true;
+            fragment.remove_prefix(prefix_left);
+        } else if (!payload_written) {
+            prefix_left -= fragment.size();
+        }
+        _body.write(fragment);
+    }
+    if (!payload_written) {
+        write_payload();
+    }
+    set_frame_flag(cql_frame_flags::custom_payload);
+}
+
 void cql_server::response::write_bytes(bytes b)
 {
     write_int(cast_if_fits<int32_t>(b.size()));
@@ -72,9 +72,10 @@ enum class cql_compression {
 };
 
 enum cql_frame_flags {
-    compression = 0x01,
-    tracing     = 0x02,
-    warning     = 0x08,
+    compression    = 0x01,
+    tracing        = 0x02,
+    custom_payload = 0x04,
+    warning        = 0x08,
 };
 
 struct [[gnu::packed]] cql_binary_frame_v1 {
@@ -177,6 +178,11 @@ class cql_server : public seastar::peering_sharded_service<cql_server>, public g
     service::migration_listener* get_migration_listener() const noexcept;
 
     future<utils::chunked_vector<client_data>> get_client_data();
+
+    // Attaches a hint naming the current shard, which should have received a
+    // bounced request, to its response. Rebuilds the response body, so it has
+    // to run on the shard which owns the response.
+    static void add_shard_hint(result_with_foreign_response_ptr& res, const cql_server_config& config);
 private:
     class fmt_visitor;
     friend class connection;
@@ -12,7 +12,10 @@
 
 #include <boost/regex/icu.hpp>
 #include <boost/locale/encoding.hpp>
+#include <cstring>
+#include <optional>
 #include <string>
+#include <vector>
 
 namespace {
 
@@ -75,10 +78,83 @@ wstring regex_from_pattern(bytes_view pattern) {
     return re;
 }
 
+/// Splits a pattern without '_' wildcards at its '%' wildcards, unescaping the literal parts.
+///
+/// Returns nullopt if the pattern has a '_' wildcard.  The literal parts are returned as UTF-8, so
+/// they can be searched for in the text byte by byte: UTF-8 is self-synchronizing, so a byte match
+/// of a valid UTF-8 string is always a match of whole characters.
+std::optional<std::vector<bytes>> literals_from_pattern(bytes_view pattern) {
+    using namespace boost::locale::conv;
+    wstring wpattern = utf_to_utf<wchar_t>(pattern.begin(), pattern.end(), stop);
+    std::vector<wstring> wliterals(1);
+    bool escaping = false;
+    for (const wchar_t c : wpattern) {
+        if (escaping) {
+            wliterals.back().push_back(c);
+            escaping = false;
+        } else if (c == L'\\') {
+            escaping = true;
+        } else if (c == L'_') {
+            return std::nullopt;
+        } else if (c == L'%') {
+            wliterals.emplace_back();
+        } else {
+            wliterals.back().push_back(c);
+        }
+    }
+    if (escaping) {
+        // An unescaped backslash at the end matches itself, see regex_from_pattern().
+        wliterals.back().push_back(L'\\');
+    }
+    std::vector<bytes> literals;
+    literals.reserve(wliterals.size());
+    for (const auto& w : wliterals) {
+        auto s = utf_to_utf<char>(w.begin(), w.end(), stop);
+        literals.emplace_back(reinterpret_cast<const int8_t*>(s.data()), s.size());
+    }
+    return literals;
+}
+
+/// Matches text against "L0%L1%...%Ln", where Li are literals_from_pattern().
+///
+/// L0 must be a prefix of the text and Ln a suffix; the others are looked for left to right, taking
+/// the leftmost occurrence of each, which is never worse than any later one.
+bool match_literals(const std::vector<bytes>& literals, bytes_view text) {
+    const bytes& first = literals.front();
+    if (literals.size() == 1) {
+        return text == first;
+    }
+    const bytes& last = literals.back();
+    if (text.size() < first.size() + last.size()
+            || text.substr(0, first.size()) != first
+            || text.substr(text.size() - last.size()) != last) {
+        return false;
+    }
+    // What remains between the prefix and the suffix.
+    text = text.substr(first.size(), text.size() - first.size() - last.size());
+    for (size_t i = 1; i + 1 < literals.size(); ++i) {
+        const bytes& literal = literals[i];
+        if (literal.empty()) {
+            continue;
+        }
+        // glibc's memmem() is vectorized, which makes it much faster than a byte-by-byte search.
+        auto found = static_cast<const bytes::value_type*>(::memmem(text.data(), text.size(), literal.data(), literal.size()));
+        if (!found) {
+            return false;
+        }
+        text.remove_prefix(found - text.data() + literal.size());
+    }
+    return true;
+}
+
 } // anonymous namespace
 
 class like_matcher::impl {
     bytes _pattern;
+    // When the pattern has no '_' wildcards, it is matched by searching for the literals between its
+    // '%' wildcards, which covers the common 'prefix%', '%suffix' and '%infix%' patterns.  Otherwise
+    // it is matched by _re.
+    std::optional<std::vector<bytes>> _literals;
     boost::u32regex _re; // Performs pattern matching.
   public:
     explicit impl(bytes_view pattern);
@@ -86,7 +162,12 @@ class like_matcher::impl {
     void reset(bytes_view pattern);
   private:
     void init_re() {
-        _re = boost::make_u32regex(regex_from_pattern(_pattern), boost::u32regex::basic | boost::u32regex::optimize);
+        _literals = literals_from_pattern(_pattern);
+        if (_literals) {
+            _re = boost::u32regex();
+        } else {
+            _re = boost::make_u32regex(regex_from_pattern(_pattern), boost::u32regex::basic | boost::u32regex::optimize);
+        }
     }
 };
 
@@ -95,6 +176,9 @@ like_matcher::impl::impl(bytes_view pattern) : _pattern(pattern) {
 }
 
 bool like_matcher::impl::operator()(bytes_view text) const {
+    if (_literals) {
+        return match_literals(*_literals, text);
+    }
     return boost::u32regex_match(text.begin(), text.end(), _re);
 }
 
@@ -362,9 +362,19 @@ static thread_local tracker& tracker_instance = get_tracker_instance();
 
 using clock = std::chrono::steady_clock;
 
+// Runs in the background, in its own scheduling group, so that allocations
+// rarely have to reclaim memory synchronously. It releases memory to the
+// standard allocator when free memory runs low, and otherwise defragments LSA
+// memory when the segment pool has fewer free segments than its goal.
 class background_reclaimer {
     scheduling_group _sg;
     noncopyable_function<void (size_t target)> _reclaim;
+    // Returns how far (0 to 1) the segment pool is from its free segments goal.
+    noncopyable_function<float ()> _defragment_urgency;
+    // Returns false if it made no progress.
+    noncopyable_function<bool ()> _defragment;
+    // Set when defragmentation made no progress, until the next adjust_shares().
+    bool _defragment_exhausted = false;
     timer<lowres_clock> _adjust_shares_timer;
     // If engaged, main loop is not running, set_value() to wake it.
     promise<>* _main_loop_wait = nullptr;
@@ -372,13 +382,21 @@ class background_reclaimer {
     bool _stopping = false;
     static constexpr size_t free_memory_threshold = 60'000'000;
 private:
-    bool have_work() const {
+    bool memory_is_low() const {
 #ifndef SEASTAR_DEFAULT_ALLOCATOR
         return memory::stats().free_memory() < free_memory_threshold;
 #else
         return false;
 #endif
     }
+    // Free segments gained by defragmenting would be handed right back to
+    // the standard allocator by reclaim() while memory is low, so don't.
+    bool need_defragment() const {
+        return !_defragment_exhausted && !memory_is_low() && _defragment_urgency() > 0;
+    }
+    bool have_work() const {
+        return memory_is_low() || need_defragment();
+    }
     void main_loop_wake() {
         llogger.debug("background_reclaimer::main_loop_wake: waking {}", bool(_main_loop_wait));
         if (_main_loop_wait) {
@@ -400,14 +418,23 @@ class background_reclaimer {
             if (_stopping) {
                 break;
             }
-            _reclaim(free_memory_threshold - memory::stats().free_memory());
+            if (memory_is_low()) {
+                _reclaim(free_memory_threshold - memory::stats().free_memory());
+            } else if (need_defragment() && !_defragment()) {
+                _defragment_exhausted = true;
+            }
             co_await coroutine::maybe_yield();
         }
         llogger.debug("background_reclaimer::main_loop: exit");
     }
     void adjust_shares() {
+        _defragment_exhausted = false;
         if (have_work()) {
-            auto shares = 1 + (1000 * (free_memory_threshold - memory::stats().free_memory())) / free_memory_threshold;
+            float urgency = _defragment_urgency();
+            if (memory_is_low()) {
+                urgency = std::max(urgency, float(free_memory_threshold - memory::stats().free_memory()) / free_memory_threshold);
+            }
+            auto shares = 1 + size_t(1000 * urgency);
             _sg.set_shares(shares);
             llogger.trace("background_reclaimer::adjust_shares: {}", shares);
             if (_main_loop_wait) {
@@ -416,9 +443,12 @@ class background_reclaimer {
         }
     }
 public:
-    explicit background_reclaimer(scheduling_group sg, noncopyable_function<void (size_t target)> reclaim)
+    explicit background_reclaimer(scheduling_group sg, noncopyable_function<void (size_t target)> reclaim,
+            noncopyable_function<float ()> defragment_urgency, noncopyable_function<bool ()> defragment)
             : _sg(sg)
             , _reclaim(std::move(reclaim))
+            , _defragment_urgency(std::move(defragment_urgency))
+            , _defragment(std::move(defragment))
             , _adjust_shares_timer(default_scheduling_group(), [this] { adjust_shares(); })
             , _done(with_scheduling_group(_sg, [this] { return main_loop(); })) {
         if (sg != default_scheduling_group()) {
@@ -439,6 +469,12 @@ class tracker::impl {
     bool _reclaiming_enabled = true;
     size_t _reclamation_step = 1;
     bool _abort_on_bad_alloc = false;
+    size_t _defragment_free_segments_goal = 0;
+    struct defragment_stats {
+        uint64_t segments_compacted = 0;
+        uint64_t memory_compacted = 0;
+        uint64_t segments_freed = 0;
+    } _defragment_stats;
 private:
     // Prevents tracker's reclaimer from running while live. Reclaimer may be
     // invoked synchronously with allocator. This guard ensures that this
@@ -462,7 +498,9 @@ class tracker::impl {
     ~impl();
     future<> stop() {
         if (_background_reclaimer) {
-            return _background_reclaimer->stop();
+            return _background_reclaimer->stop().then([this] {
+                _background_reclaimer.reset();
+            });
         } else {
             return make_ready_future<>();
         }
@@ -489,12 +527,14 @@ class tracker::impl {
     // Abort on allocation failure from LSA
     void enable_abort_on_bad_alloc() { _abort_on_bad_alloc = true; }
     bool should_abort_on_bad_alloc() const { return _abort_on_bad_alloc; }
-    void setup_background_reclaim(scheduling_group sg) {
-        assert(!_background_reclaimer);
-        _background_reclaimer.emplace(sg, [this] (size_t target) {
-            reclaim(target, is_preemptible::yes);
-        });
-    }
+    void setup_background_reclaim(scheduling_group sg, size_t defragment_free_segments_goal);
+    // Returns how far (0 to 1) the segment pool is from having _defragment_free_segments_goal
+    // free segments, or 0 if LSA memory isn't fragmented enough for compaction to get there.
+    float defragment_urgency();
+    // Compacts the sparsest segments, without evicting, until the segment pool has
+    // _defragment_free_segments_goal free segments, so that allocating a segment
+    // doesn't have to compact synchronously. Returns false if no segment could be compacted.
+    bool defragment(is_preemptible p);
 private:
     // Like compact_and_evict() but assumes that reclaim_lock is held around the operation.
     size_t compact_and_evict_locked(size_t reserve_segments, size_t bytes, is_preemptible preempt);
@@ -2126,7 +2166,7 @@ void tracker::configure(const config& cfg) {
     if (cfg.abort_on_lsa_bad_alloc) {
         _impl->enable_abort_on_bad_alloc();
     }
-    _impl->setup_background_reclaim(cfg.background_reclaim_sched_group);
+    _impl->setup_background_reclaim(cfg.background_reclaim_sched_group, cfg.defragment_free_segments_goal);
     s_sanitizer_report_backtrace = cfg.sanitizer_report_backtrace;
 }
 
@@ -2357,6 +2397,83 @@ idle_cpu_handler_result tracker::impl::compact_on_idle(work_waiting_on_reactor c
     return idle_cpu_handler_result::interrupted_by_higher_priority_task;
 }
 
+void tracker::impl::setup_background_reclaim(scheduling_group sg, size_t defragment_free_segments_goal) {
+    assert(!_background_reclaimer);
+    _defragment_free_segments_goal = defragment_free_segments_goal;
+    _background_reclaimer.emplace(sg, [this] (size_t target) {
+        reclaim(target, is_preemptible::yes);
+    }, [this] {
+        return defragment_urgency();
+    }, [this] {
+        return defragment(is_preemptible::yes);
+    });
+}
+
+float tracker::impl::defragment_urgency() {
+    auto goal = _defragment_free_segments_goal;
+    auto free_segments = shard_segment_pool.free_segments();
+    if (!goal || !_reclaiming_enabled || free_segments >= goal) {
+        return 0;
+    }
+    // Don't depend on whether the pool could still grow: free memory is kept
+    // above the threshold at which growing stops, by reclaim().
+    if (region_occupancy().free_space() < (goal - free_segments) * segment::size) {
+        return 0;
+    }
+    return float(goal - free_segments) / goal;
+}
+
+bool tracker::impl::defragment(is_preemptible preempt) {
+    if (!_reclaiming_enabled) {
+        return false;
+    }
+    reclaiming_lock rl(*this);
+    if (_regions.empty()) {
+        return false;
+    }
+    // Compaction may need a segment before it frees one.
+    segment_pool::reservation_goal open_emergency_pool(shard_segment_pool, 0);
+
+    auto cmp = [] (region::impl* c1, region::impl* c2) {
+        if (c1->is_compactible() != c2->is_compactible()) {
+            return !c1->is_compactible();
+        }
+        return c2->min_occupancy() < c1->min_occupancy();
+    };
+
+    boost::range::make_heap(_regions, cmp);
+
+    auto free_segments = shard_segment_pool.free_segments();
+    uint64_t compacted = 0;
+    reclaim_timer timing_guard("defragment", preempt, 0, _defragment_free_segments_goal - std::min(_defragment_free_segments_goal, free_segments), this);
+    while (shard_segment_pool.free_segments() < _defragment_free_segments_goal) {
+        boost::range::pop_heap(_regions, cmp);
+        region::impl* r = _regions.back();
+
+        // Compacting dense segments costs more than it frees, leave those
+        // to reclaim(), which can evict instead.
+        auto occupancy = r->min_occupancy();
+        if (!r->is_compactible() || occupancy.used_space() > max_used_space_for_compaction) {
+            break;
+        }
+
+        r->compact();
+        ++compacted;
+        _defragment_stats.segments_compacted++;
+        _defragment_stats.memory_compacted += occupancy.used_space();
+
+        boost::range::push_heap(_regions, cmp);
+
+        if (preempt && need_preempt()) {
+            break;
+        }
+    }
+    auto freed = shard_segment_pool.free_segments() - std::min(shard_segment_pool.free_segments(), free_segments);
+    _defragment_stats.segments_freed += freed;
+    timing_guard.set_memory_released(freed * segment::size);
+    return compacted > 0;
+}
+
 size_t tracker::impl::reclaim(size_t memory_to_release, is_preemptible preempt) {
     if (!_reclaiming_enabled) {
         return 0;
@@ -2589,6 +2706,16 @@ tracker::impl::impl() {
 
         sm::make_counter("memory_freed", [] { return shard_segment_pool.statistics().memory_freed; },
                         sm::description("Counts number of bytes which were requested to be freed in LSA.")),
+
+        sm::make_counter("defragment_segments_compacted", [this] { return _defragment_stats.segments_compacted; },
+                        sm::description("Counts a number of segments compacted by background defragmentation. Also counted in segments_compacted.")),
+
+        sm::make_counter("defragment_memory_compacted", [this] { return _defragment_stats.memory_compacted; },
+                        sm::description("Counts number of bytes which were copied by background defragmentation. Also counted in memory_compacted.")),
+
+        sm::make_counter("defragment_segments_freed", [this] { return _defragment_stats.segments_freed; },
+                        sm::description("Counts a number of free segments gained by background defragmentation. "
+                                        "The ratio to defragment_segments_compacted is the efficiency of defragmentation.")),
     });
 }
 
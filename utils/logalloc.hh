@@ -422,6 +422,9 @@ class tracker {
         bool sanitizer_report_backtrace = false; // Better reports but slower
         size_t lsa_reclamation_step;
         scheduling_group background_reclaim_sched_group;
+        // Number of free segments which the background reclaimer keeps in the
+        // segment pool by compacting sparse segments. 0 disables it.
+        size_t defragment_free_segments_goal = 0;
     };
 
     void configure(const config& cfg);